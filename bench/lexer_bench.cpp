@@ -0,0 +1,88 @@
+// Compares the table-driven scanner against the scanner generated from the
+// same DFA, on the same input. The table path uses the built-in tables unless
+// a DFA file is given.
+// usage: lexer_bench <source.pas> [repeat] [dfa.json]
+#include "lexer/lexer.hpp"
+#include "lexer/dfa_loader.hpp"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+template <class F>
+static double best_of(int runs, F&& f) {
+    double best = 1e100;
+    for (int r = 0; r < runs; ++r) {
+        auto t0 = std::chrono::steady_clock::now();
+        f();
+        auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(t1 - t0).count());
+    }
+    return best;
+}
+
+static void report(const char* name, double secs, size_t bytes, size_t tokens) {
+    std::cout << name << ": " << secs * 1000.0 << " ms, "
+              << (bytes / secs) / (1024.0 * 1024.0) << " MiB/s, "
+              << (tokens / secs) / 1e6 << " Mtok/s\n";
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <source.pas> [repeat] [dfa.json]\n";
+        return 1;
+    }
+    int repeat = argc > 2 ? std::stoi(argv[2]) : 1;
+
+    std::ifstream f(argv[1]);
+    if (!f) {
+        std::cerr << "Cannot open source: " << argv[1] << "\n";
+        return 1;
+    }
+    std::string unit((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    std::string src;
+    src.reserve(unit.size() * repeat + repeat);
+    for (int r = 0; r < repeat; ++r) {
+        src += unit;
+        src += '\n';
+    }
+
+    CompiledDFA dfa = builtin_dfa();
+    if (argc > 3) {
+        try {
+            dfa = load_dfa_json(argv[3]).compile();
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to load DFA: " << e.what() << "\n";
+            return 1;
+        }
+    }
+
+    std::vector<Token> table_tokens, gen_tokens;
+    try {
+        double t_table = best_of(5, [&] { table_tokens = Lexer(dfa, src).tokenize(); });
+        double t_gen = best_of(5, [&] { gen_tokens = Lexer(src).tokenize(); });
+
+        std::cout << "input: " << src.size() << " bytes, " << table_tokens.size() << " tokens\n";
+        report("table    ", t_table, src.size(), table_tokens.size());
+        report("generated", t_gen, src.size(), gen_tokens.size());
+        std::cout << "speedup: " << t_table / t_gen << "x\n";
+    } catch (const LexerError& e) {
+        std::cerr << "LEXER ERROR: " << e.what() << "\n";
+        return 1;
+    }
+
+    // both paths must agree token for token
+    bool same = table_tokens.size() == gen_tokens.size();
+    for (size_t k = 0; same && k < table_tokens.size(); ++k) {
+        const Token& a = table_tokens[k];
+        const Token& b = gen_tokens[k];
+        same = a.kind == b.kind && a.value == b.value && a.line == b.line && a.column == b.column;
+    }
+    if (!same) {
+        std::cerr << "MISMATCH between table and generated token streams\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,101 @@
+// Lexer::tokenize and Parser::pars_program throughput over generated
+// Pascal-S sources from 1 KB up to 100 MB. Prints one JSON object per size
+// and stage (JSON Lines), so runs can be appended to a log and compared for
+// regressions. The parse figures include streaming the tokens from the
+// lexer and releasing the tree; parse_program_compact is the same with
+// ParserOptions::compact_expressions.
+// usage: lexer_throughput [max-bytes] [seed]
+#include "lexer/lexer.hpp"
+#include "parser/parser.hpp"
+#include "pascal_gen.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+// every heap allocation in the process goes through these
+static std::atomic<size_t> alloc_count{0};
+static std::atomic<size_t> alloc_bytes{0};
+
+void* operator new(size_t n) {
+    alloc_count.fetch_add(1, std::memory_order_relaxed);
+    alloc_bytes.fetch_add(n, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+struct Sample {
+    size_t bytes = 0;
+    size_t tokens = 0;
+    int runs = 0;
+    double best = 1e100;  // seconds
+    size_t allocs = 0;    // in one pass
+    size_t alloc_bytes = 0;
+};
+
+// run() does one pass and returns the token count
+template <class F>
+static Sample measure(const std::string& src, F&& run) {
+    Sample s;
+    s.bytes = src.size();
+    // at least 3 runs, more for small inputs (up to ~1 s in total)
+    double spent = 0;
+    while (s.runs < 3 || (spent < 1.0 && s.runs < 1000)) {
+        size_t c0 = alloc_count.load(), b0 = alloc_bytes.load();
+        auto t0 = std::chrono::steady_clock::now();
+        s.tokens = run();
+        auto t1 = std::chrono::steady_clock::now();
+        double secs = std::chrono::duration<double>(t1 - t0).count();
+        s.allocs = alloc_count.load() - c0;
+        s.alloc_bytes = alloc_bytes.load() - b0;
+        s.best = std::min(s.best, secs);
+        spent += secs;
+        ++s.runs;
+    }
+    return s;
+}
+
+static void report(const char* bench, size_t target, const Sample& s) {
+    char line[512];
+    std::snprintf(line, sizeof line,
+                  "{\"bench\":\"%s\",\"target_bytes\":%zu,\"bytes\":%zu,\"tokens\":%zu,"
+                  "\"runs\":%d,\"seconds\":%.6f,\"tokens_per_sec\":%.0f,\"bytes_per_sec\":%.0f,"
+                  "\"allocations\":%zu,\"allocated_bytes\":%zu}",
+                  bench, target, s.bytes, s.tokens, s.runs, s.best, s.tokens / s.best, s.bytes / s.best,
+                  s.allocs, s.alloc_bytes);
+    std::cout << line << std::endl;
+}
+
+int main(int argc, char** argv) {
+    size_t max_bytes = argc > 1 ? std::stoull(argv[1]) : 100u << 20;
+    uint32_t seed = argc > 2 ? static_cast<uint32_t>(std::stoul(argv[2])) : 1;
+
+    for (size_t size = 1 << 10; size <= max_bytes; size *= 10) {
+        std::string src = PascalGenerator(seed).program(size);
+        try {
+            report("lexer_tokenize", size, measure(src, [&] { return Lexer(src).tokenize().size(); }));
+            report("parse_program", size, measure(src, [&] {
+                Lexer lex(src);
+                Parser(lex).pars_program();
+                return lex.token_count();
+            }));
+            report("parse_program_compact", size, measure(src, [&] {
+                Lexer lex(src);
+                Parser parser(lex);
+                parser.set_options(ParserOptions{true});
+                parser.pars_program();
+                return lex.token_count();
+            }));
+        } catch (const std::exception& e) {
+            std::cerr << "ERROR on generated input (" << size << " bytes): " << e.what() << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
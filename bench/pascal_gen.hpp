@@ -0,0 +1,90 @@
+// Synthetic Pascal-S source for benchmarks: a program in the project's
+// dialect (konstanta, tipe/larik, nested prosedur/fungsi, { } and (* *)
+// comments, string literals), grown unit by unit to roughly the requested
+// size. Output depends only on (bytes, seed); it lexes cleanly and parses.
+#pragma once
+#include <cstdint>
+#include <string>
+
+class PascalGenerator {
+public:
+    explicit PascalGenerator(uint32_t seed = 1) : state(seed ? seed : 1) {}
+
+    std::string program(size_t bytes) {
+        std::string out;
+        out.reserve(bytes + 4096);
+        out += "program Bench;\n\n";
+        out += "{ generated benchmark input: the units below are independent }\n";
+        out += "konstanta\n  LIMIT = 100;\n  STEP = 3;\n  GREETING = 'halo, dunia';\n\n";
+        out += "tipe\n  Index = 1..100;\n  Data = larik[1..100] dari integer;\n\n";
+        out += "variabel\n  i, total: integer;\n  ratio: real;\n  done: boolean;\n  buf: Data;\n\n";
+
+        // at least one unit; the main block adds about 300 bytes
+        size_t units = 0;
+        while (units == 0 || out.size() + 300 < bytes) {
+            unit(out, units++);
+        }
+
+        out += "mulai\n  total := 0;\n  done := false;\n";
+        for (size_t u = units > 8 ? units - 8 : 0; u < units; ++u) {
+            out += "  P" + std::to_string(u) + "(" + num(100) + ", total);\n";
+        }
+        out += "  writeln('total = ', total)\nselesai.\n";
+        return out;
+    }
+
+private:
+    uint32_t state;
+
+    uint32_t next() { // xorshift32
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+    std::string num(uint32_t below) { return std::to_string(next() % below); }
+
+    void comment(std::string& out, const std::string& indent) {
+        static const char* words[] = {"hitung", "nilai", "sementara", "indeks", "batas", "hasil",
+                                      "periksa", "ulang", "data", "jumlah", "langkah", "akhir"};
+        bool brace = next() % 2;
+        out += indent;
+        out += brace ? "{ " : "(* ";
+        size_t n = 4 + next() % 12;
+        for (size_t k = 0; k < n; ++k) {
+            out += words[next() % 12];
+            out += (k % 6 == 5) ? "\n" + indent + "  " : " ";
+        }
+        out += brace ? "}\n" : "*)\n";
+    }
+
+    void unit(std::string& out, size_t u) {
+        const std::string id = std::to_string(u);
+        const std::string t = "t" + id, f = "F" + id;
+
+        comment(out, "");
+        out += "prosedur P" + id + "(x: integer; y: integer);\n";
+        out += "variabel\n  " + t + ", k: integer;\n  c: char;\n";
+        out += "  fungsi " + f + "(v: integer): integer;\n";
+        out += "  variabel\n    w: integer;\n";
+        out += "  mulai\n";
+        out += "    w := v * " + num(9) + " + " + num(50) + ";\n";
+        out += "    " + f + " := w mod " + std::to_string(2 + next() % 7) + "\n";
+        out += "  selesai;\n";
+        out += "mulai\n";
+        comment(out, "  ");
+        out += "  " + t + " := " + f + "(x) bagi STEP;\n";
+        out += "  c := 'q';\n";
+        out += "  jika (" + t + " > y) dan (x <> 0) maka\n";
+        out += "    writeln('unit " + id + " memproses data ke-" + num(1000) + "', " + t + ")\n";
+        out += "  selain-itu\n";
+        out += "    mulai\n";
+        out += "      untuk k := 1 ke " + num(20) + " lakukan\n";
+        out += "        " + t + " := " + t + " + k mod 7;\n";
+        out += "      selama (" + t + " > 0) atau tidak (y = " + num(5) + ") lakukan\n";
+        out += "        " + t + " := " + t + " - 1;\n";
+        out += "      ratio := " + num(100) + ".5 / 2.0\n";
+        out += "    selesai\n";
+        out += "selesai;\n\n";
+    }
+};
@@ -33,7 +33,7 @@ public:
 
 class ASTVarDeclNode : public ASTNode {
 public:
-    std::vector<std::string> identifiers;
+    std::vector<Atom> identifiers;
     std::string type_name;
     
     std::string getNodeType() const override { return "VarDecl"; }
@@ -55,7 +55,7 @@ public:
 
 class ASTAssignmentNode : public ASTStatementNode {
 public:
-    std::string variable_name;
+    Atom variable_name;
     std::unique_ptr<class ASTExpressionNode> expression;
     
     std::string getNodeType() const override { return "Assignment"; }
@@ -83,7 +83,7 @@ public:
 
 class ASTForNode : public ASTStatementNode {
 public:
-    std::string control_var;
+    Atom control_var;
     std::unique_ptr<class ASTExpressionNode> initial_value;
     std::unique_ptr<class ASTExpressionNode> final_value;
     bool is_downto;
@@ -95,7 +95,7 @@ public:
 
 class ASTProcedureCallNode : public ASTStatementNode {
 public:
-    std::string procedure_name;
+    Atom procedure_name;
     std::vector<std::unique_ptr<class ASTExpressionNode>> arguments;
     
     std::string getNodeType() const override { return "ProcedureCall"; }
@@ -137,7 +137,7 @@ public:
 
 class ASTIdentifierNode : public ASTExpressionNode {
 public:
-    std::string name;
+    Atom name;
     
     std::string getNodeType() const override { return "Identifier"; }
     void accept(ASTVisitor* visitor) override;
@@ -145,7 +145,7 @@ public:
 
 class ASTFunctionCallNode : public ASTExpressionNode {
 public:
-    std::string function_name;
+    Atom function_name;
     std::vector<std::unique_ptr<ASTExpressionNode>> arguments;
     
     std::string getNodeType() const override { return "FunctionCall"; }
@@ -12,6 +12,9 @@ public:
     // main entry point - build AST from parse tree
     std::unique_ptr<ASTProgramNode> buildAST(const ProgramNode* parse_tree);
     
+    // helper - determine literal type from token (Parser::ast_program uses it too)
+    static std::string getLiteralType(const Token& token);
+    
 private:
     // translation functions untuk setiap production rule
     
@@ -57,11 +60,14 @@ private:
     // factor → identifier | number | string | ( expression ) | not factor | function-call
     std::unique_ptr<ASTExpressionNode> translateFactor(const FactorNode* node);
     
-    // helper - extract identifier names from identifier list
-    std::vector<std::string> extractIdentifiers(const IdentifierListNode* node);
+    // identifier | number | string | char | benar | salah
+    std::unique_ptr<ASTExpressionNode> translateOperand(const Token& token);
     
-    // helper - determine literal type from token
-    std::string getLiteralType(const Token& token);
+    // function-call → identifier ( expression-list? )
+    std::unique_ptr<ASTExpressionNode> translateFunctionCall(const ProcedureFunctionCallNode* node);
+    
+    // helper - extract identifier names from identifier list
+    std::vector<Atom> extractIdentifiers(const IdentifierListNode* node);
 };
 
 #endif // AST_BUILDER_HPP
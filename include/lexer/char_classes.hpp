@@ -1,10 +1,65 @@
 #pragma once
-#include <string>
-#include <unordered_set>
+#include <array>
 
-extern const std::unordered_set<std::string> KEYWORDS;
-extern const std::unordered_set<std::string> LOGICAL_WORDS;
-extern const std::unordered_set<std::string> ARITH_WORDS;
+// Bit flags, one per class label a DFA transition may name
+enum CharClass : unsigned char
+{
+    CC_NEWLINE    = 1 << 0,
+    CC_WHITESPACE = 1 << 1,
+    CC_LETTER     = 1 << 2,
+    CC_DIGIT      = 1 << 3,
+    CC_UNDERSCORE = 1 << 4,
+    CC_DASH       = 1 << 5,
+    CC_SYMBOL     = 1 << 6,
+};
 
-// Return a set of class labels for a single character
-std::unordered_set<std::string> classify_char(char ch);
+struct CharClassName
+{
+    const char *name;
+    unsigned char bit;
+};
+
+// Class labels in the priority order the DFA compiler tries them
+inline constexpr CharClassName CHAR_CLASS_NAMES[] = {
+    {"newline", CC_NEWLINE},
+    {"whitespace", CC_WHITESPACE},
+    {"letter", CC_LETTER},
+    {"digit", CC_DIGIT},
+    {"underscore", CC_UNDERSCORE},
+    {"dash", CC_DASH},
+    {"symbol", CC_SYMBOL},
+};
+
+constexpr std::array<unsigned char, 256> make_char_class_table()
+{
+    std::array<unsigned char, 256> t{};
+    for (int c = 0; c < 256; ++c)
+    {
+        unsigned char m = 0;
+        if (c == '\n')
+            m |= CC_NEWLINE;
+        if (c == ' ' || c == '\t' || c == '\r')
+            m |= CC_WHITESPACE;
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))
+            m |= CC_LETTER;
+        if (c >= '0' && c <= '9')
+            m |= CC_DIGIT;
+        if (c == '_')
+            m |= CC_UNDERSCORE;
+        if (c == '-')
+            m |= CC_DASH;
+        for (const char *s = "+-*/=<>()[];,:'."; *s; ++s)
+            if (c == static_cast<unsigned char>(*s))
+                m |= CC_SYMBOL;
+        t[c] = m;
+    }
+    return t;
+}
+
+// byte -> CharClass bitmask, built at compile time
+inline constexpr std::array<unsigned char, 256> CHAR_CLASS_TABLE = make_char_class_table();
+
+inline unsigned char char_class_mask(char ch)
+{
+    return CHAR_CLASS_TABLE[static_cast<unsigned char>(ch)];
+}
@@ -1,8 +1,12 @@
 #pragma once
+#include "scanner.hpp"
+#include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 struct PairHash
 {
@@ -15,6 +19,8 @@ struct PairHash
     }
 };
 
+class CompiledDFA;
+
 class DFA
 {
 public:
@@ -30,12 +36,79 @@ public:
     // returns next state or empty string if not found
     std::string next_state(const std::string &state, const std::string &inp) const;
 
+    // resolve every (state, byte) pair into a dense integer table
+    CompiledDFA compile() const;
+
 private:
     std::string start_state;
     std::unordered_set<std::string> final_states;
     std::unordered_map<std::pair<std::string, std::string>, std::string, PairHash> transitions; // (state, inp) -> next
 };
 
+// Dense form of a DFA: states are integer ids and every state owns a row of
+// 256 byte columns. Symbolic inputs (char classes, "any", "any_non_quote")
+// are resolved once at compile time, so one step is a single array index.
+//
+// The tables are not owned directly: they live either in `storage` (built by
+// DFA::compile) or in static data baked into the binary (builtin_dfa), so
+// copying a CompiledDFA is cheap and never copies the table.
+class CompiledDFA
+{
+public:
+    static constexpr int DEAD = -1;
+
+    CompiledDFA() = default;
+    CompiledDFA(int start_state, size_t num_states, const std::string_view *names,
+                const unsigned char *finals, const int *table,
+                std::shared_ptr<const void> storage = nullptr)
+        : start_state(start_state), num_states(num_states), names(names), finals(finals), table(table),
+          storage(std::move(storage)) {}
+
+    int start() const { return start_state; }
+    int next(int state, unsigned char c) const { return table[static_cast<size_t>(state) * 256 + c]; }
+    bool is_final(int state) const { return finals[state] != 0; }
+    std::string_view name(int state) const { return names[state]; }
+    size_t size() const { return num_states; }
+
+    // longest match starting at `from`
+    ScanMatch scan(std::string_view src, size_t from) const;
+
+private:
+    int start_state = DEAD;
+    size_t num_states = 0;
+    const std::string_view *names = nullptr; // state id -> state name
+    const unsigned char *finals = nullptr;   // state id -> 1 if accepting
+    const int *table = nullptr;              // state id * 256 + byte -> next state id or DEAD
+    std::shared_ptr<const void> storage;     // keeps the arrays above alive (null for built-in tables)
+};
+
+// Default DFA (dfa/dfa.json), generated into constexpr tables at build time
+// by tools/gen_scanner, so using it costs no file I/O or parsing.
+const CompiledDFA &builtin_dfa();
+
 // Loaders
 DFA load_dfa_txt(const std::string &path);
 DFA load_dfa_json(const std::string &path);
+
+// What minimize_dfa found. Unreachable states cannot be entered from the
+// start state; dead states are entered but can never reach an accepting one.
+struct DFAReport
+{
+    std::vector<std::string> unreachable;
+    std::vector<std::string> dead;
+    size_t states_before = 0;
+    size_t states_after = 0;
+};
+
+// Hopcroft minimization: drops unreachable states and merges equivalent
+// ones. Accepting states are only merged when they share a name, since the
+// name is what the lexer maps to a token kind. Missing transitions are kept
+// distinct from dead states, so every walk stops at the same byte as before.
+CompiledDFA minimize_dfa(const CompiledDFA &dfa, DFAReport *report = nullptr);
+
+// Precompiled binary DFA (.dfa): versioned header, interned state names,
+// final-state bitmap and the dense transition table, in native byte order.
+// load_dfa_bin maps the file and uses the table in place; save_dfa_bin
+// writes a CompiledDFA out in that format. Both throw std::runtime_error.
+CompiledDFA load_dfa_bin(const std::string &path);
+void save_dfa_bin(const CompiledDFA &dfa, const std::string &path);
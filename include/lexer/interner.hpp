@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+// Interned identifier: equal spellings get the same atom, so later stages
+// (parser, symbol table, AST) compare names as integers.
+using Atom = uint32_t;
+constexpr Atom NO_ATOM = static_cast<Atom>(-1);
+
+// Pool of interned names. Atoms are handed out densely (0, 1, 2, ...) in
+// order of first appearance. The text is copied into the pool, so atom names
+// stay valid after the source buffer is gone.
+// Not thread-safe: the lexer interns on one thread only (parallel chunks are
+// interned while they are stitched).
+class Interner
+{
+public:
+    Interner() = default;
+    Interner(const Interner &) = delete;
+    Interner &operator=(const Interner &) = delete;
+
+    Atom intern(std::string_view name);
+    // NO_ATOM if name was never interned
+    Atom find(std::string_view name) const;
+    std::string_view name(Atom atom) const { return names[atom]; }
+    size_t size() const { return names.size(); }
+
+    // the pool shared by the lexer and everything downstream
+    static Interner &global();
+
+private:
+    static constexpr size_t BLOCK = 1 << 16;
+
+    static uint32_t hash(std::string_view name);
+    size_t slot_of(std::string_view name, uint32_t h) const;
+    void grow();
+
+    // open addressing, linear probing; slots hold atoms (NO_ATOM = empty)
+    std::vector<Atom> slots;
+    std::vector<uint32_t> hashes; // per atom, so growing does not rehash text
+    std::vector<std::string_view> names;
+    std::vector<std::unique_ptr<char[]>> blocks;
+    size_t block_left = 0;
+};
+
+inline Atom intern(std::string_view name) { return Interner::global().intern(name); }
+inline std::string_view atom_name(Atom atom) { return Interner::global().name(atom); }
@@ -2,32 +2,190 @@
 #include "dfa_loader.hpp"
 #include "token.hpp"
 #include "char_classes.hpp"
+#include "line_index.hpp"
+#include "token_buffer.hpp"
+#include "source_buffer.hpp"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <stdexcept>
 
+enum class LexErrorCode : unsigned char
+{
+    UNEXPECTED_CHARACTER, // the span ends with the offending byte
+    UNEXPECTED_END,       // input (or a NUL byte) ended a partial token
+    UNTERMINATED_BRACE_COMMENT, // { ...
+    UNTERMINATED_PAREN_COMMENT, // (* ...
+};
+
+// A lexical error as recorded while scanning: no text, just where it is.
+// Messages are only formatted when the errors are thrown.
+struct LexDiagnostic
+{
+    LexErrorCode code;
+    uint32_t offset;
+    uint32_t length;
+};
+
 class LexerError : public std::runtime_error
 {
 public:
     explicit LexerError(const std::string &msg) : std::runtime_error(msg) {}
+    LexerError(const std::string &msg, std::vector<LexDiagnostic> diags, bool stopped)
+        : std::runtime_error(msg), diags(std::move(diags)), stopped(stopped) {}
+
+    // in source order; empty if the error did not come from scanning
+    const std::vector<LexDiagnostic> &diagnostics() const { return diags; }
+    // lexing gave up at the error limit, so there may be more errors
+    bool stopped_early() const { return stopped; }
+
+private:
+    std::vector<LexDiagnostic> diags;
+    bool stopped = false;
+};
+
+struct LexerOptions
+{
+    size_t max_errors = 0;  // stop lexing at this many errors; 0 = no limit
+    bool fail_fast = false; // stop at the first one (same as max_errors = 1)
+    // tokenize_parallel lexes on one thread below this many bytes per thread
+    size_t parallel_min_chunk = 1 << 18;
+};
+
+// An edit to a source buffer: `removed` bytes at `offset` were replaced by
+// `inserted` (offset is the same in the old and the new text)
+struct SourceEdit
+{
+    size_t offset = 0;
+    size_t removed = 0;
+    std::string_view inserted;
+};
+
+// Tokens [first, first + inserted) of the new stream replace tokens
+// [first, first + removed) of the old one; the rest are unchanged apart
+// from their position
+struct TokenRange
+{
+    size_t first = 0;
+    size_t removed = 0;
+    size_t inserted = 0;
 };
 
 class Lexer
 {
 public:
-    Lexer(const DFA &dfa, std::string source)
-        : dfa(dfa), src(std::move(source)), i(0), line(1), col(1) {}
+    // source is borrowed: tokens view into it, so it must outlive them.
+    // Table-driven scanner over a DFA loaded at runtime (--dfa).
+    Lexer(const CompiledDFA &dfa, std::string_view source)
+        : dfa(&dfa), generated(false), src(checked_source(source)), i(0) { intern_state_names(); }
+
+    // Built-in scanner generated from dfa/dfa.json at build time
+    explicit Lexer(std::string_view source)
+        : dfa(&builtin_dfa()), generated(true), src(checked_source(source)), i(0) { intern_state_names(); }
 
+    void set_options(const LexerOptions &options)
+    {
+        error_limit = options.fail_fast ? 1 : options.max_errors;
+        min_chunk = options.parallel_min_chunk;
+    }
+
+    // Streaming: the next token, or a TokenKind::NONE token at end of input.
+    // Lexical errors are collected as scanning goes and thrown together as
+    // one LexerError when the end is reached, or as soon as the error limit
+    // is hit.
+    Token next_token();
+
+    // all remaining tokens at once
     std::vector<Token> tokenize();
 
+    // all remaining tokens, stored column-wise (see TokenBuffer); the buffer
+    // borrows this lexer's line index, so it must not outlive the lexer
+    TokenBuffer tokenize_buffer();
+
+    // Same result as tokenize(), lexed on up to `threads` threads. The source
+    // is split at newlines and every chunk is lexed speculatively, as if it
+    // started between tokens; the chunks are then stitched in order, and a
+    // chunk whose real entry point differs (a comment, string or token ran
+    // across the split) is relexed from there until it meets one of its
+    // speculative token starts again. Small sources just use tokenize().
+    std::vector<Token> tokenize_parallel(unsigned threads);
+
+    // Incremental relex. The lexer is built over the edited text; tokens is
+    // the stream lexed from the text before `edit`. Lexing restarts after
+    // the last token whose DFA walk never reached the edit, and stops as
+    // soon as it is back between tokens at a point where the old stream
+    // also was (shifted by the edit). tokens is updated in place: the
+    // changed range is replaced, the others are rebased onto the new text.
+    // Throws LexerError (leaving tokens alone) if the relexed part has
+    // lexical errors, and std::invalid_argument if the edit is not in the
+    // source or the old tokens run past the end of the text before it.
+    TokenRange relex(std::vector<Token> &tokens, const SourceEdit &edit);
+
+    // lex whatever is left (e.g. after the parser stopped early), so the
+    // collected errors are raised and token_count() is the full count
+    void finish();
+
+    size_t token_count() const { return produced; }
+
+    // line starts of the source, built on the first next_token(); maps Token::offset
+    // (or any other offset) back to line/column
+    const LineIndex &line_index() const { return lines; }
+
 private:
-    const DFA &dfa;
-    std::string src;
-    size_t i;
-    int line, col;
-
-    char peek(int k = 0) const;
-    char advance();
-    void skip_ws_comment(std::vector<std::string>& errors);
-    std::string map_state_to_type(const std::string &state, const std::string &lex) const;
+    const CompiledDFA *dfa;
+    bool generated; // scan with generated_scan (same state ids as builtin_dfa)
+    std::vector<TokenKind> state_kinds; // accepting state id -> kind, UNKNOWN: by lexeme
+    std::vector<Atom> state_atoms; // accepting state id -> atom of its name
+    std::string_view src;
+    size_t i; // only a byte offset is tracked while scanning
+    LineIndex lines;
+    bool started = false;
+    size_t line_hint = 0; // tokens come in source order
+    size_t produced = 0;
+    std::vector<LexDiagnostic> errors;
+    bool errors_reported = false;
+    size_t error_limit = 0;
+    size_t min_chunk = LexerOptions().parallel_min_chunk;
+
+    // Offset where a token (or an error) starts, i.e. where the lexer is
+    // between tokens, with how much of the span was lexed before it
+    struct SyncPoint
+    {
+        size_t offset;
+        uint32_t tokens_before;
+        uint32_t errors_before;
+    };
+
+    // Tokens and errors lexed over one chunk
+    struct Span
+    {
+        static constexpr size_t NOT_SYNCED = static_cast<size_t>(-1);
+        std::vector<Token> tokens;
+        std::vector<LexDiagnostic> errors;
+        std::vector<SyncPoint> points;
+        size_t resume = 0;                 // first point at or past the limit
+        bool ended = false;                // reached end of input
+        size_t synced = NOT_SYNCED;        // sync->points index where lexing rejoined
+    };
+
+    // These take the cursor explicitly and only read the lexer, so chunks
+    // can be lexed concurrently.
+    char at(size_t k) const;
+    void skip_ws_comment(size_t &pos, std::vector<LexDiagnostic> &errs) const;
+    bool scan_token(size_t &pos, Token &out, std::vector<LexDiagnostic> &errs, size_t &hint) const;
+    void lex_span(size_t from, size_t limit, Span &out, const Span *sync) const;
+    bool at_error_limit(const std::vector<LexDiagnostic> &errs) const
+    {
+        return error_limit != 0 && errs.size() >= error_limit;
+    }
+    void format_error(std::string &out, const LexDiagnostic &d) const;
+    [[noreturn]] void throw_errors(std::vector<LexDiagnostic> errs) const;
+    static TokenKind lexeme_kind(std::string_view lex);
+    // throws LexerError past MAX_SOURCE_SIZE, where 32-bit offsets would wrap
+    static std::string_view checked_source(std::string_view source)
+    {
+        if (source.size() > MAX_SOURCE_SIZE) throw LexerError("Source too large for the lexer");
+        return source;
+    }
+    void intern_state_names();
 };
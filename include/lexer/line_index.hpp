@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// 1-based line and column (column counts bytes, as the lexer always has)
+struct SourcePos
+{
+    int line = 0;
+    int column = 0;
+};
+
+// Offsets where each line of a source text starts, found with one SIMD
+// newline scan. Lets the lexer track plain byte offsets and turn them into
+// line/column only where a position is actually reported.
+class LineIndex
+{
+public:
+    LineIndex() = default;
+    explicit LineIndex(std::string_view src);
+
+    // any offset, by binary search over the line starts
+    SourcePos position(size_t offset) const;
+
+    // same result, but walks forward from *hint (a 0-based line): O(1)
+    // amortized when offsets come in increasing order, as tokens do
+    SourcePos position_from(size_t offset, size_t *hint) const;
+
+    size_t line_count() const { return starts.size(); }
+    size_t line_start(size_t line) const { return starts[line - 1]; } // 1-based line
+
+private:
+    std::vector<uint32_t> starts; // starts[k] = offset of line k + 1
+};
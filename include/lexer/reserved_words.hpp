@@ -0,0 +1,114 @@
+#pragma once
+#include "token.hpp"
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+// Reserved words (lowercase) -> token kind: keywords, logical and arithmetic words
+struct ReservedWord
+{
+    std::string_view name;
+    TokenKind kind;
+};
+
+inline constexpr ReservedWord RESERVED_WORDS[] = {
+    {"program", TokenKind::KW_PROGRAM}, {"konstanta", TokenKind::KW_KONSTANTA},
+    {"tipe", TokenKind::KW_TIPE}, {"variabel", TokenKind::KW_VARIABEL},
+    {"prosedur", TokenKind::KW_PROSEDUR}, {"fungsi", TokenKind::KW_FUNGSI},
+    {"mulai", TokenKind::KW_MULAI}, {"selesai", TokenKind::KW_SELESAI},
+    {"jika", TokenKind::KW_JIKA}, {"maka", TokenKind::KW_MAKA},
+    {"selain-itu", TokenKind::KW_SELAIN_ITU}, {"selama", TokenKind::KW_SELAMA},
+    {"lakukan", TokenKind::KW_LAKUKAN}, {"untuk", TokenKind::KW_UNTUK},
+    {"ke", TokenKind::KW_KE}, {"turun-ke", TokenKind::KW_TURUN_KE},
+    {"ulangi", TokenKind::KW_ULANGI}, {"sampai", TokenKind::KW_SAMPAI},
+    {"kasus", TokenKind::KW_KASUS}, {"dari", TokenKind::KW_DARI},
+    {"larik", TokenKind::KW_LARIK}, {"rekaman", TokenKind::KW_REKAMAN},
+    {"integer", TokenKind::KW_INTEGER}, {"real", TokenKind::KW_REAL},
+    {"boolean", TokenKind::KW_BOOLEAN}, {"char", TokenKind::KW_CHAR},
+    {"string", TokenKind::KW_STRING},
+    {"true", TokenKind::KW_TRUE}, {"false", TokenKind::KW_FALSE},
+
+    {"dan", TokenKind::DAN}, {"atau", TokenKind::ATAU}, {"tidak", TokenKind::TIDAK},
+
+    {"bagi", TokenKind::BAGI}, {"mod", TokenKind::MOD}
+};
+
+// ASCII-only lowercase; identifiers never hold anything else
+constexpr char fold_ascii(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+}
+
+// Perfect hash over RESERVED_WORDS, found at compile time: the hash only
+// reads the length and the first, middle and last bytes, and the seed search
+// below picks a seed for which no two reserved words share a slot.
+inline constexpr unsigned RESERVED_HASH_BITS = 7;
+inline constexpr size_t RESERVED_HASH_SLOTS = size_t(1) << RESERVED_HASH_BITS;
+
+constexpr uint32_t reserved_hash(std::string_view w, uint32_t seed)
+{
+    uint32_t h = seed ^ static_cast<uint32_t>(w.size());
+    h = (h ^ static_cast<unsigned char>(fold_ascii(w[0]))) * 0x01000193u;
+    h = (h ^ static_cast<unsigned char>(fold_ascii(w[w.size() / 2]))) * 0x01000193u;
+    h = (h ^ static_cast<unsigned char>(fold_ascii(w[w.size() - 1]))) * 0x01000193u;
+    return (h * 0x9E3779B1u) >> (32 - RESERVED_HASH_BITS);
+}
+
+constexpr uint32_t find_reserved_seed()
+{
+    for (uint32_t seed = 1; seed < 100000; ++seed)
+    {
+        bool used[RESERVED_HASH_SLOTS] = {};
+        bool ok = true;
+        for (const auto &rw : RESERVED_WORDS)
+        {
+            uint32_t h = reserved_hash(rw.name, seed);
+            if (used[h])
+            {
+                ok = false;
+                break;
+            }
+            used[h] = true;
+        }
+        if (ok)
+            return seed;
+    }
+    return 0;
+}
+
+inline constexpr uint32_t RESERVED_SEED = find_reserved_seed();
+static_assert(RESERVED_SEED != 0, "no perfect hash seed for RESERVED_WORDS");
+
+// slot -> index into RESERVED_WORDS, or -1
+constexpr std::array<signed char, RESERVED_HASH_SLOTS> make_reserved_slots()
+{
+    std::array<signed char, RESERVED_HASH_SLOTS> slots{};
+    for (auto &s : slots)
+        s = -1;
+    for (size_t k = 0; k < std::size(RESERVED_WORDS); ++k)
+        slots[reserved_hash(RESERVED_WORDS[k].name, RESERVED_SEED)] = static_cast<signed char>(k);
+    return slots;
+}
+
+inline constexpr std::array<signed char, RESERVED_HASH_SLOTS> RESERVED_SLOTS = make_reserved_slots();
+
+inline constexpr size_t RESERVED_MIN_LEN = 2;
+inline constexpr size_t RESERVED_MAX_LEN = 10;
+
+// Case-insensitive reserved-word lookup on the lexeme itself (no copy);
+// IDENTIFIER if it is not reserved
+inline TokenKind reserved_word_kind(std::string_view lexeme)
+{
+    if (lexeme.size() < RESERVED_MIN_LEN || lexeme.size() > RESERVED_MAX_LEN)
+        return TokenKind::IDENTIFIER;
+    int k = RESERVED_SLOTS[reserved_hash(lexeme, RESERVED_SEED)];
+    if (k < 0)
+        return TokenKind::IDENTIFIER;
+    const ReservedWord &rw = RESERVED_WORDS[k];
+    if (rw.name.size() != lexeme.size())
+        return TokenKind::IDENTIFIER;
+    for (size_t j = 0; j < lexeme.size(); ++j)
+        if (fold_ascii(lexeme[j]) != rw.name[j])
+            return TokenKind::IDENTIFIER;
+    return rw.kind;
+}
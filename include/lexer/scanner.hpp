@@ -0,0 +1,16 @@
+#pragma once
+#include <cstddef>
+#include <string_view>
+
+// Result of one maximal-munch walk from a token start. Only byte offsets are
+// tracked; line/column come from a LineIndex when needed.
+struct ScanMatch
+{
+    int state;   // last accepting state id, or -1 if none was reached
+    size_t end;  // just past the accepted lexeme (valid when state >= 0)
+    size_t stop; // where the walk got stuck
+};
+
+// Scanner generated at build time from dfa/dfa.json (see tools/gen_scanner.cpp).
+// State ids match builtin_dfa(), which also gives their names.
+ScanMatch generated_scan(std::string_view src, size_t from);
@@ -0,0 +1,18 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Block scans used by the lexer's whitespace/comment skipping. Each walks
+// p[i, n) 32 bytes at a time with AVX2 or 16 with SSE2, whichever the build
+// targets (e.g. add -mavx2 to CXXFLAGS), and finishes byte by byte. Building
+// with -DLEXER_NO_SIMD forces the scalar loops everywhere.
+
+// first index >= i that is not ' ', '\t', '\r' or '\n'; n if none
+size_t skip_blanks(const char *p, size_t i, size_t n);
+
+// first index >= i holding byte a or byte b; n if none
+size_t find_either(const char *p, size_t i, size_t n, char a, char b);
+
+// appends the offset just past every '\n' in p[0, n) to out, in order
+void collect_line_starts(const char *p, size_t n, std::vector<uint32_t> &out);
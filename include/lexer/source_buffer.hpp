@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <stdexcept>
+
+// Largest source the lexer handles: token offsets, lengths and line starts
+// are stored as uint32_t
+constexpr size_t MAX_SOURCE_SIZE = UINT32_MAX;
+
+// Read-only source text for the lexer. Regular files are memory-mapped so
+// the lexer reads straight from the page cache; pipes, stdin ("-") and
+// platforms without mmap fall back to reading into an owned string.
+class SourceBuffer
+{
+public:
+    SourceBuffer() = default;
+    ~SourceBuffer();
+
+    SourceBuffer(SourceBuffer &&other) noexcept;
+    SourceBuffer &operator=(SourceBuffer &&other) noexcept;
+    SourceBuffer(const SourceBuffer &) = delete;
+    SourceBuffer &operator=(const SourceBuffer &) = delete;
+
+    // throws std::runtime_error if the file cannot be opened or read, or is
+    // larger than MAX_SOURCE_SIZE
+    static SourceBuffer open(const std::string &path);
+
+    std::string_view view() const { return std::string_view(data, size); }
+    bool is_mapped() const { return mapped; }
+
+private:
+    const char *data = nullptr;
+    size_t size = 0;
+    bool mapped = false;
+    std::string owned;
+
+    void release();
+};
@@ -1,18 +1,174 @@
 #pragma once
+#include "interner.hpp"
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <sstream>
 
+// Token kinds produced by the lexer. Reserved words and operators get their
+// own kind so the parser never has to compare strings; the printable
+// category (KEYWORD, ARITHMETIC_OPERATOR, ...) comes from token_kind_name().
+enum class TokenKind : unsigned char
+{
+    NONE, // default-constructed / absent token
+
+    IDENTIFIER,
+    NUMBER,
+    STRING_LITERAL,
+    CHAR_LITERAL,
+
+    // reserved words
+    KW_PROGRAM,
+    KW_KONSTANTA,
+    KW_TIPE,
+    KW_VARIABEL,
+    KW_PROSEDUR,
+    KW_FUNGSI,
+    KW_MULAI,
+    KW_SELESAI,
+    KW_JIKA,
+    KW_MAKA,
+    KW_SELAIN_ITU,
+    KW_SELAMA,
+    KW_LAKUKAN,
+    KW_UNTUK,
+    KW_KE,
+    KW_TURUN_KE,
+    KW_ULANGI,
+    KW_SAMPAI,
+    KW_KASUS,
+    KW_DARI,
+    KW_LARIK,
+    KW_REKAMAN,
+    KW_INTEGER,
+    KW_REAL,
+    KW_BOOLEAN,
+    KW_CHAR,
+    KW_STRING,
+    KW_TRUE,
+    KW_FALSE,
+
+    // logical words
+    DAN,
+    ATAU,
+    TIDAK,
+
+    // arithmetic operators
+    PLUS,
+    MINUS,
+    STAR,
+    SLASH,
+    BAGI,
+    MOD,
+
+    // relational operators
+    EQ,
+    NEQ,
+    LT,
+    LE,
+    GT,
+    GE,
+
+    ASSIGN,
+    RANGE,
+
+    // punctuation
+    SEMICOLON,
+    COMMA,
+    COLON,
+    DOT,
+    LPARENTHESIS,
+    RPARENTHESIS,
+    LBRACKET,
+    RBRACKET,
+
+    COMMENT_START,
+    COMMENT_END,
+
+    UNKNOWN // accepting state the lexer has no mapping for
+};
+
+inline bool is_keyword(TokenKind k)
+{
+    return k >= TokenKind::KW_PROGRAM && k <= TokenKind::KW_FALSE;
+}
+
+inline bool is_logical_operator(TokenKind k)
+{
+    return k >= TokenKind::DAN && k <= TokenKind::TIDAK;
+}
+
+inline bool is_arithmetic_operator(TokenKind k)
+{
+    return k >= TokenKind::PLUS && k <= TokenKind::MOD;
+}
+
+inline bool is_relational_operator(TokenKind k)
+{
+    return k >= TokenKind::EQ && k <= TokenKind::GE;
+}
+
+// Printable token category, as shown in token dumps and parse trees
+inline const char *token_kind_name(TokenKind k)
+{
+    if (is_keyword(k)) return "KEYWORD";
+    if (is_logical_operator(k)) return "LOGICAL_OPERATOR";
+    if (is_arithmetic_operator(k)) return "ARITHMETIC_OPERATOR";
+    if (is_relational_operator(k)) return "RELATIONAL_OPERATOR";
+    switch (k)
+    {
+    case TokenKind::NONE: return "";
+    case TokenKind::IDENTIFIER: return "IDENTIFIER";
+    case TokenKind::NUMBER: return "NUMBER";
+    case TokenKind::STRING_LITERAL: return "STRING_LITERAL";
+    case TokenKind::CHAR_LITERAL: return "CHAR_LITERAL";
+    case TokenKind::ASSIGN: return "ASSIGN_OPERATOR";
+    case TokenKind::RANGE: return "RANGE_OPERATOR";
+    case TokenKind::SEMICOLON: return "SEMICOLON";
+    case TokenKind::COMMA: return "COMMA";
+    case TokenKind::COLON: return "COLON";
+    case TokenKind::DOT: return "DOT";
+    case TokenKind::LPARENTHESIS: return "LPARENTHESIS";
+    case TokenKind::RPARENTHESIS: return "RPARENTHESIS";
+    case TokenKind::LBRACKET: return "LBRACKET";
+    case TokenKind::RBRACKET: return "RBRACKET";
+    case TokenKind::COMMENT_START: return "COMMENT_START";
+    case TokenKind::COMMENT_END: return "COMMENT_END";
+    default: return "UNKNOWN";
+    }
+}
+
+// Token kind printed with its DFA state name when the lexer has no mapping
+// for it (UNKNOWN tokens carry the state name's atom)
+inline std::string_view token_type_name(TokenKind k, Atom atom)
+{
+    if (k == TokenKind::UNKNOWN && atom != NO_ATOM) return atom_name(atom);
+    return token_kind_name(k);
+}
+
+// A token does not own its text: value views into the source buffer handed
+// to the Lexer, which must outlive every token (and parse tree node) made
+// from it. Use text() where an owned copy is needed.
+// line/column are filled in from the lexer's LineIndex; offset is the byte
+// offset of the token in the source. Identifiers also carry their atom in
+// the global Interner, UNKNOWN tokens the atom of their DFA state name;
+// other tokens have NO_ATOM.
 struct Token
 {
-    std::string type;
-    std::string value;
-    int line;
-    int column;
+    TokenKind kind = TokenKind::NONE;
+    uint32_t offset = 0; // sits in kind's padding
+    std::string_view value;
+    int line = 0;
+    int column = 0;
+    Atom atom = NO_ATOM;
+
+    std::string_view type() const { return token_type_name(kind, atom); }
+    std::string text() const { return std::string(value); }
 
     std::string toString() const
     {
         std::ostringstream oss;
-        oss << type << "(" << value << ")";
+        oss << type() << "(" << value << ")";
         return oss.str();
     }
 };
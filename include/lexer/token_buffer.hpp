@@ -0,0 +1,66 @@
+#pragma once
+#include "token.hpp"
+#include "line_index.hpp"
+#include "interner.hpp"
+#include "source_buffer.hpp"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Token stream stored column by column (structure of arrays): one entry per
+// token in each of kinds, offsets, lengths and atoms. The parser's hot loop
+// only looks at kinds, so it walks one byte per token instead of a whole
+// Token, and never touches the source text. Line/column are not stored at
+// all; token() derives them from the line index when a Token is needed.
+//
+// Like Token, the buffer does not own the text: offsets point into the
+// source, which must outlive the buffer. The line index is borrowed too,
+// normally from the Lexer that filled the buffer.
+//
+// Offsets and lengths are 32-bit: that is lossless because sources are
+// capped at MAX_SOURCE_SIZE (SourceBuffer::open and the Lexer reject larger
+// ones), so a token can neither start nor run past UINT32_MAX.
+static_assert(MAX_SOURCE_SIZE <= UINT32_MAX, "TokenBuffer stores offsets and lengths as uint32_t");
+
+class TokenBuffer
+{
+public:
+    TokenBuffer() = default;
+    TokenBuffer(std::string_view source, const LineIndex &lines)
+        : src(source), lines(&lines) {}
+
+    // identifiers are interned unless atom is given
+    void push(TokenKind kind, uint32_t offset, uint32_t length, Atom atom = NO_ATOM);
+    // t.value.size() fits: t lies inside a source of at most MAX_SOURCE_SIZE bytes
+    void push(const Token &t) { push(t.kind, t.offset, static_cast<uint32_t>(t.value.size()), t.atom); }
+    void append(const std::vector<Token> &tokens);
+    void reserve(size_t n);
+
+    size_t size() const { return kinds.size(); }
+    bool empty() const { return kinds.empty(); }
+
+    TokenKind kind(size_t k) const { return kinds[k]; }
+    uint32_t offset(size_t k) const { return offsets[k]; }
+    uint32_t length(size_t k) const { return lengths[k]; }
+    std::string_view text(size_t k) const { return src.substr(offsets[k], lengths[k]); }
+
+    // atom of an identifier (see Interner), NO_ATOM for other tokens
+    Atom atom(size_t k) const { return atoms[k]; }
+
+    const std::vector<TokenKind> &kind_column() const { return kinds; }
+
+    // the full Token, line/column by binary search
+    Token token(size_t k) const;
+    // same, walking forward from *line_hint (see LineIndex::position_from)
+    Token token(size_t k, size_t *line_hint) const;
+
+    const LineIndex &line_index() const { return *lines; }
+
+private:
+    std::string_view src;
+    const LineIndex *lines = nullptr;
+    std::vector<TokenKind> kinds;
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> lengths;
+    std::vector<Atom> atoms;
+};
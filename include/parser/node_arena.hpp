@@ -0,0 +1,109 @@
+#ifndef NODE_ARENA_HPP
+#define NODE_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Bump allocator for parse tree nodes. Objects are never destroyed one by
+// one: only trivially destructible types go in, and the whole arena is
+// released at once with its blocks.
+class NodeArena {
+public:
+    NodeArena() = default;
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    void* allocate(size_t size, size_t align) {
+        uintptr_t p = (reinterpret_cast<uintptr_t>(cur) + align - 1) & ~(uintptr_t)(align - 1);
+        if (!cur || p + size > reinterpret_cast<uintptr_t>(end)) return allocate_slow(size, align);
+        cur = reinterpret_cast<char*>(p + size);
+        return reinterpret_cast<void*>(p);
+    }
+
+    template <class T, class... Args>
+    T* make(Args&&... args) {
+        static_assert(std::is_trivially_destructible<T>::value, "arena objects are never destroyed");
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    size_t bytes_reserved() const { return reserved; }
+
+private:
+    static constexpr size_t BLOCK = 64 * 1024;
+
+    void* allocate_slow(size_t size, size_t align) {
+        size_t want = size + align > BLOCK ? size + align : BLOCK;
+        blocks.emplace_back(new char[want]);
+        reserved += want;
+        cur = blocks.back().get();
+        end = cur + want;
+        return allocate(size, align);
+    }
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    char* cur = nullptr;
+    char* end = nullptr;
+    size_t reserved = 0;
+};
+
+// Non-owning pointer to a node in a NodeArena. Reads like the unique_ptr it
+// replaces (get, ->, bool), but copying it is free and it has nothing to
+// destroy.
+template <class T>
+class NodePtr {
+public:
+    NodePtr() = default;
+    NodePtr(std::nullptr_t) {}
+    explicit NodePtr(T* p) : p(p) {}
+    template <class U, class = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    NodePtr(NodePtr<U> other) : p(other.get()) {}
+
+    T* get() const { return p; }
+    T* operator->() const { return p; }
+    T& operator*() const { return *p; }
+    explicit operator bool() const { return p != nullptr; }
+    bool operator==(std::nullptr_t) const { return p == nullptr; }
+    bool operator!=(std::nullptr_t) const { return p != nullptr; }
+
+private:
+    T* p = nullptr;
+};
+
+// Growable array whose storage lives in a NodeArena; push_back takes the
+// arena. Outgrown storage is left in the arena until it is released.
+template <class T>
+class NodeList {
+    static_assert(std::is_trivially_copyable<T>::value, "NodeList items are moved with memcpy");
+
+public:
+    void push_back(NodeArena& arena, const T& item) {
+        if (count == cap) {
+            uint32_t grown = cap ? cap * 2 : 4;
+            T* bigger = static_cast<T*>(arena.allocate(sizeof(T) * grown, alignof(T)));
+            if (count) std::memcpy(static_cast<void*>(bigger), items, sizeof(T) * count);
+            items = bigger;
+            cap = grown;
+        }
+        new (items + count++) T(item);
+    }
+
+    const T* begin() const { return items; }
+    const T* end() const { return items + count; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const T& operator[](size_t k) const { return items[k]; }
+    const T& back() const { return items[count - 1]; }
+
+private:
+    T* items = nullptr;
+    uint32_t count = 0;
+    uint32_t cap = 0;
+};
+
+#endif // NODE_ARENA_HPP
@@ -2,29 +2,60 @@
 #define PARSE_TREE_NODES_HPP
 
 #include "../lexer/token.hpp"
+#include "node_arena.hpp"
 #include <vector>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <type_traits>
+
+class ParseTreeNode;
+
+// Callback for ParseTreeNode::forEachChild: a non-owning reference to any
+// callable taking a ParseTreeNode*. Copying it is two pointers; the callable
+// must outlive the call it is passed to (a lambda argument does).
+class ChildVisitor {
+public:
+    template <class F, class = typename std::enable_if<
+                           !std::is_same<typename std::decay<F>::type, ChildVisitor>::value>::type>
+    ChildVisitor(F&& fn)
+        : fn(const_cast<void*>(static_cast<const void*>(std::addressof(fn)))),
+          call(&invoke<typename std::remove_reference<F>::type>) {}
+
+    void operator()(ParseTreeNode* child) const { call(fn, child); }
+
+private:
+    template <class F>
+    static void invoke(void* fn, ParseTreeNode* child) { (*static_cast<F*>(fn))(child); }
+
+    void* fn;
+    void (*call)(void*, ParseTreeNode*);
+};
 
 // Base Parse Tree Node
+// Nodes live in a NodeArena and are never destroyed one by one, so they
+// must stay trivially destructible: no virtual destructor, no owning
+// members (children are NodePtr/NodeList, text is string_view).
 class ParseTreeNode {
 public:
-    virtual ~ParseTreeNode() = default;
     virtual std::string toString() const { return "ParseTreeNode"; }
-    virtual std::vector<ParseTreeNode*> getChildren() const { return {}; }
+    // Calls visit on each child, in order; nothing is allocated
+    virtual void forEachChild(ChildVisitor) const {}
+    // the same children collected into a vector
+    std::vector<ParseTreeNode*> getChildren() const;
 };
 
 // Program Node
 class ProgramNode : public ParseTreeNode {
 public:
-    std::string pars_program_name;
-    std::unique_ptr<ParseTreeNode> pars_program_header;
-    std::unique_ptr<class DeclarationPartNode> pars_declaration_part;
-    std::unique_ptr<class CompoundStatementNode> pars_compound_statement;
+    std::string_view pars_program_name; // views into the source
+    NodePtr<ParseTreeNode> pars_program_header;
+    NodePtr<class DeclarationPartNode> pars_declaration_part;
+    NodePtr<class CompoundStatementNode> pars_compound_statement;
     Token dot_token;  // DOT token at end
     
     std::string toString() const override { return "<program>"; }
-    std::vector<ParseTreeNode*> getChildren() const override;
+    void forEachChild(ChildVisitor visit) const override;
 };
 
 
@@ -36,19 +67,18 @@ public:
     Token semicolon;        // SEMICOLON(;)
     
     std::string toString() const override { return "<program-header>"; }
-    std::vector<ParseTreeNode*> getChildren() const override { return {}; }
 };
 
 // Declaration Part Node
 class DeclarationPartNode : public ParseTreeNode {
 public:
-    std::vector<std::unique_ptr<class ConstDeclarationNode>> pars_const_declaration_list;
-    std::vector<std::unique_ptr<class TypeDeclarationNode>> pars_type_declaration_list;
-    std::vector<std::unique_ptr<class VariableDeclarationNode>> pars_variable_declaration_list;
-    std::vector<std::unique_ptr<class SubprogramDeclarationNode>> pars_subprogram_declaration_list;
+    NodeList<NodePtr<class ConstDeclarationNode>> pars_const_declaration_list;
+    NodeList<NodePtr<class TypeDeclarationNode>> pars_type_declaration_list;
+    NodeList<NodePtr<class VariableDeclarationNode>> pars_variable_declaration_list;
+    NodeList<NodePtr<class SubprogramDeclarationNode>> pars_subprogram_declaration_list;
     
     std::string toString() const override { return "<declaration-part>"; }
-    std::vector<ParseTreeNode*> getChildren() const override;
+    void forEachChild(ChildVisitor visit) const override;
 };
 
 // Const Declaration Node
@@ -61,7 +91,6 @@ public:
     Token semicolon;      // SEMICOLON(;)
     
     std::string toString() const override { return "<const-declaration>"; }
-    std::vector<ParseTreeNode*> getChildren() const override { return {}; }
 };
 
 // Type Declaration Node
@@ -70,45 +99,43 @@ public:
     Token type_keyword;   // KEYWORD(tipe)
     Token identifier;     // IDENTIFIER
     Token equal;          // EQUAL(=)
-    std::unique_ptr<ParseTreeNode> pars_type_definition;  // type definition (array, range, etc.)
+    NodePtr<ParseTreeNode> pars_type_definition;  // type definition (array, range, etc.)
     Token semicolon;      // SEMICOLON(;)
     
     std::string toString() const override { return "<type-declaration>"; }
-    std::vector<ParseTreeNode*> getChildren() const override;
+    void forEachChild(ChildVisitor visit) const override;
 };
 
 // Variable Declaration Node
 class VariableDeclarationNode : public ParseTreeNode {
 public:
     Token var_keyword;  // KEYWORD(variabel)
-    std::unique_ptr<class IdentifierListNode> pars_identifier_list;
+    NodePtr<class IdentifierListNode> pars_identifier_list;
     Token colon;        // COLON(:)
-    std::unique_ptr<ParseTreeNode> pars_type; 
+    NodePtr<ParseTreeNode> pars_type; 
     Token semicolon;    // SEMICOLON(;)
     
     std::string toString() const override { return "<var-declaration>"; }
-    std::vector<ParseTreeNode*> getChildren() const override;
+    void forEachChild(ChildVisitor visit) const override;
 };
 
 // Identifier List Node
 class IdentifierListNode : public ParseTreeNode {
 public:
-    std::vector<std::string> pars_identifier_list;
-    std::vector<Token> identifier_tokens;  // Store actual tokens
-    std::vector<Token> comma_tokens;       // Store comma tokens
+    NodeList<Atom> pars_identifier_list; // interned names
+    NodeList<Token> identifier_tokens;  // Store actual tokens
+    NodeList<Token> comma_tokens;       // Store comma tokens
     
     std::string toString() const override { return "<identifier-list>"; }
-    std::vector<ParseTreeNode*> getChildren() const override;
 };
 
 // Type Node
 class TypeNode : public ParseTreeNode {
 public:
-    std::string pars_type_name;
+    std::string_view pars_type_name;
     Token type_keyword; 
     
     std::string toString() const override { return "<type>"; }
-    std::vector<ParseTreeNode*> getChildren() const override;
 };
 
 
@@ -117,34 +144,34 @@ class ArrayTypeNode : public ParseTreeNode {
 public:
     Token array_keyword;  // KEYWORD(larik)
     Token lbracket;       // LBRACKET([)
-    std::unique_ptr<class RangeNode> pars_range;
+    NodePtr<class RangeNode> pars_range;
     Token rbracket;       // RBRACKET(])
     Token of_keyword;     // KEYWORD(dari)
     // FIX: Mengganti TypeNode ke ASTNode untuk mendukung tipe array anonim
-    std::unique_ptr<ParseTreeNode> pars_type;
+    NodePtr<ParseTreeNode> pars_type;
     
     std::string toString() const override { return "<array-type>"; }
-    std::vector<ParseTreeNode*> getChildren() const override;
+    void forEachChild(ChildVisitor visit) const override;
 };
 
 // Range Node
 class RangeNode : public ParseTreeNode {
 public:
-    std::unique_ptr<ParseTreeNode> pars_start_expression;
+    NodePtr<ParseTreeNode> pars_start_expression;
     Token range_operator;  // RANGE_OPERATOR(..)
-    std::unique_ptr<ParseTreeNode> pars_end_expression;
+    NodePtr<ParseTreeNode> pars_end_expression;
     
     std::string toString() const override { return "<range>"; }
-    std::vector<ParseTreeNode*> getChildren() const override;
+    void forEachChild(ChildVisitor visit) const override;
 };
 
 // Subprogram Declaration Node
 class SubprogramDeclarationNode : public ParseTreeNode {
 public:
-    std::unique_ptr<ParseTreeNode> pars_declaration;  // ProcedureDeclarationNode or FunctionDeclarationNode
+    NodePtr<ParseTreeNode> pars_declaration;  // ProcedureDeclarationNode or FunctionDeclarationNode
     
     std::string toString() const override { return "<subprogram-declaration>"; }
-    std::vector<ParseTreeNode*> getChildren() const override;
+    void forEachChild(ChildVisitor visit) const override;
 };
 
 // Procedure Declaration Node
@@ -152,13 +179,13 @@ class ProcedureDeclarationNode : public ParseTreeNode {
 public:
     Token procedure_keyword;  // KEYWORD(prosedur)
     Token identifier;         // IDENTIFIER
-    std::unique_ptr<class FormalParameterListNode> pars_formal_parameter_list;
+    NodePtr<class FormalParameterListNode> pars_formal_parameter_list;
     Token semicolon1;         // SEMICOLON(;)
-    std::unique_ptr<ParseTreeNode> pars_block;  // block (declarations + compound statement)
+    NodePtr<ParseTreeNode> pars_block;  // block (declarations + compound statement)
     Token semicolon2;         // SEMICOLON(;)
     
     std::string toString() const override { return "<procedure-declaration>"; }
-    std::vector<ParseTreeNode*> getChildren() const override;
+    void forEachChild(ChildVisitor visit) const override;
 };
 
 // Function Declaration Node
@@ -166,40 +193,40 @@ class FunctionDeclarationNode : public ParseTreeNode {
 public:
     Token function_keyword;   // KEYWORD(fungsi)
     Token identifier;         // IDENTIFIER
-    std::unique_ptr<class FormalParameterListNode> pars_formal_parameter_list;
+    NodePtr<class FormalParameterListNode> pars_formal_parameter_list;
     Token colon;              // COLON(:)
     // FIX: Mengganti TypeNode ke ASTNode untuk mendukung tipe array anonim
-    std::unique_ptr<ParseTreeNode> pars_return_type;
+    NodePtr<ParseTreeNode> pars_return_type;
     Token semicolon1;         // SEMICOLON(;)
-    std::unique_ptr<ParseTreeNode> pars_block;  // block
+    NodePtr<ParseTreeNode> pars_block;  // block
     Token semicolon2;         // SEMICOLON(;)
     
     std::string toString() const override { return "<function-declaration>"; }
-    std::vector<ParseTreeNode*> getChildren() const override;
+    void forEachChild(ChildVisitor visit) const override;
 };
 
 // Formal Parameter List Node
 class FormalParameterListNode : public ParseTreeNode {
 public:
     Token lparen;  // LPARENTHESIS(()
-    std::vector<std::unique_ptr<class ParameterGroupNode>> pars_parameter_groups;
-    std::vector<Token> semicolon_tokens;  // SEMICOLON tokens between groups
+    NodeList<NodePtr<class ParameterGroupNode>> pars_parameter_groups;
+    NodeList<Token> semicolon_tokens;  // SEMICOLON tokens between groups
     Token rparen;  // RPARENTHESIS())
     
     std::string toString() const override { return "<formal-parameter-list>"; }
-    std::vector<ParseTreeNode*> getChildren() const override;
+    void forEachChild(ChildVisitor visit) const override;
 };
 
 // Parameter Group Node (for formal parameters like "x, y: integer")
 class ParameterGroupNode : public ParseTreeNode {
 public:
-    std::unique_ptr<class IdentifierListNode> pars_identifier_list;
+    NodePtr<class IdentifierListNode> pars_identifier_list;
     Token colon;  // COLON(:)
     // FIX: Mengganti TypeNode ke ASTNode untuk mendukung tipe array anonim
-    std::unique_ptr<ParseTreeNode> pars_type;
+    NodePtr<ParseTreeNode> pars_type;
     
     std::string toString() const override { return "<parameter-group>"; }
-    std::vector<ParseTreeNode*> getChildren() const override;
+    void forEachChild(ChildVisitor visit) const override;
 };
 
 
@@ -208,20 +235,20 @@ public:
 class CompoundStatementNode : public ParseTreeNode {
 public:
     Token mulai_keyword;   // KEYWORD(mulai)
-    std::vector<std::unique_ptr<ParseTreeNode>> pars_statement_list;
+    NodeList<NodePtr<ParseTreeNode>> pars_statement_list;
     Token selesai_keyword; // KEYWORD(selesai)
     
     std::string toString() const override { return "<compound-statement>"; }
-    std::vector<ParseTreeNode*> getChildren() const override;
+    void forEachChild(ChildVisitor visit) const override;
 };
 
 // Statement List Node
 class StatementListNode : public ParseTreeNode {
 public:
-    std::vector<std::unique_ptr<ParseTreeNode>> pars_statements;
+    NodeList<NodePtr<ParseTreeNode>> pars_statements;
     
     std::string toString() const override { return "<statement-list>"; }
-    std::vector<ParseTreeNode*> getChildren() const override;
+    void forEachChild(ChildVisitor visit) const override;
 };
 
 // Token Node (for terminal symbols)
@@ -234,41 +261,40 @@ public:
     std::string toString() const override {
         return token.toString();
     }
-    std::vector<ParseTreeNode*> getChildren() const override { return {}; }
 };
 
 class AssignmentStatementNode : public ParseTreeNode {
 public:
     Token identifier;
     Token assign_operator;
-    std::unique_ptr<ParseTreeNode> pars_expression;
+    NodePtr<ParseTreeNode> pars_expression;
     
     std::string toString() const override { return "<assignment-statement>"; }
-    std::vector<ParseTreeNode*> getChildren() const override;
+    void forEachChild(ChildVisitor visit) const override;
 };
 
 class IfStatementNode : public ParseTreeNode {
 public:
     Token if_keyword;
-    std::unique_ptr<ParseTreeNode> pars_condition;
+    NodePtr<ParseTreeNode> pars_condition;
     Token then_keyword;
-    std::unique_ptr<ParseTreeNode> pars_then_statement;
+    NodePtr<ParseTreeNode> pars_then_statement;
     Token else_keyword;
-    std::unique_ptr<ParseTreeNode> pars_else_statement;
+    NodePtr<ParseTreeNode> pars_else_statement;
     
     std::string toString() const override { return "<if-statement>"; }
-    std::vector<ParseTreeNode*> getChildren() const override;
+    void forEachChild(ChildVisitor visit) const override;
 };
 
 class WhileStatementNode : public ParseTreeNode {
 public:
     Token while_keyword;
-    std::unique_ptr<ParseTreeNode> pars_condition;
+    NodePtr<ParseTreeNode> pars_condition;
     Token do_keyword;
-    std::unique_ptr<ParseTreeNode> pars_body;
+    NodePtr<ParseTreeNode> pars_body;
     
     std::string toString() const override { return "<while-statement>"; }
-    std::vector<ParseTreeNode*> getChildren() const override;
+    void forEachChild(ChildVisitor visit) const override;
 };
 
 class ForStatementNode : public ParseTreeNode {
@@ -276,63 +302,63 @@ public:
     Token for_keyword;
     Token control_variable;
     Token assign_operator;
-    std::unique_ptr<ParseTreeNode> pars_initial_value;
+    NodePtr<ParseTreeNode> pars_initial_value;
     Token direction_keyword;
-    std::unique_ptr<ParseTreeNode> pars_final_value;
+    NodePtr<ParseTreeNode> pars_final_value;
     Token do_keyword;
-    std::unique_ptr<ParseTreeNode> pars_body;
+    NodePtr<ParseTreeNode> pars_body;
     
     std::string toString() const override { return "<for-statement>"; }
-    std::vector<ParseTreeNode*> getChildren() const override;
+    void forEachChild(ChildVisitor visit) const override;
 };
 
 class ProcedureFunctionCallNode : public ParseTreeNode {
 public:
     Token procedure_name;
     Token lparen;
-    std::unique_ptr<ParseTreeNode> pars_parameter_list;
+    NodePtr<ParseTreeNode> pars_parameter_list;
     Token rparen;
     
     std::string toString() const override { return "<procedure/function-call>"; }
-    std::vector<ParseTreeNode*> getChildren() const override;
+    void forEachChild(ChildVisitor visit) const override;
 };
 
 class ParameterListNode : public ParseTreeNode {
 public:
-    std::vector<std::unique_ptr<ParseTreeNode>> pars_parameters;
-    std::vector<Token> comma_tokens;
+    NodeList<NodePtr<ParseTreeNode>> pars_parameters;
+    NodeList<Token> comma_tokens;
     
     std::string toString() const override { return "<parameter-list>"; }
-    std::vector<ParseTreeNode*> getChildren() const override;
+    void forEachChild(ChildVisitor visit) const override;
 };
 
 class ExpressionNode : public ParseTreeNode {
 public:
-    std::unique_ptr<ParseTreeNode> pars_left;
-    std::unique_ptr<class RelationalOperatorNode> pars_relational_op;
-    std::unique_ptr<ParseTreeNode> pars_right;
+    NodePtr<ParseTreeNode> pars_left;
+    NodePtr<class RelationalOperatorNode> pars_relational_op;
+    NodePtr<ParseTreeNode> pars_right;
     
     std::string toString() const override { return "<expression>"; }
-    std::vector<ParseTreeNode*> getChildren() const override;
+    void forEachChild(ChildVisitor visit) const override;
 };
 
 class SimpleExpressionNode : public ParseTreeNode {
 public:
     Token sign;
-    std::vector<std::unique_ptr<ParseTreeNode>> pars_terms;
-    std::vector<std::unique_ptr<class AdditiveOperatorNode>> pars_operators;
+    NodeList<NodePtr<ParseTreeNode>> pars_terms;
+    NodeList<NodePtr<class AdditiveOperatorNode>> pars_operators;
     
     std::string toString() const override { return "<simple-expression>"; }
-    std::vector<ParseTreeNode*> getChildren() const override;
+    void forEachChild(ChildVisitor visit) const override;
 };
 
 class TermNode : public ParseTreeNode {
 public:
-    std::vector<std::unique_ptr<ParseTreeNode>> pars_factors;
-    std::vector<std::unique_ptr<class MultiplicativeOperatorNode>> pars_operators;
+    NodeList<NodePtr<ParseTreeNode>> pars_factors;
+    NodeList<NodePtr<class MultiplicativeOperatorNode>> pars_operators;
     
     std::string toString() const override { return "<term>"; }
-    std::vector<ParseTreeNode*> getChildren() const override;
+    void forEachChild(ChildVisitor visit) const override;
 };
 
 
@@ -340,11 +366,34 @@ class FactorNode : public ParseTreeNode {
 public:
     Token token;
     Token not_operator;
-    std::unique_ptr<ParseTreeNode> pars_expression;
-    std::unique_ptr<class ProcedureFunctionCallNode> pars_procedure_function_call;
+    NodePtr<ParseTreeNode> pars_expression;
+    NodePtr<class ProcedureFunctionCallNode> pars_procedure_function_call;
     
     std::string toString() const override { return "<factor>"; }
-    std::vector<ParseTreeNode*> getChildren() const override;
+    void forEachChild(ChildVisitor visit) const override;
+};
+
+// Compact expression nodes (ParserOptions::compact_expressions): one node
+// per operator instead of an expression/simple-expression/term/factor chain.
+// Operands are these, a TokenNode for a literal or identifier, or a
+// ProcedureFunctionCallNode; parentheses leave no node behind.
+class BinaryExpressionNode : public ParseTreeNode {
+public:
+    NodePtr<ParseTreeNode> pars_left;
+    Token op_token;  // relational, additive or multiplicative operator
+    NodePtr<ParseTreeNode> pars_right;
+    
+    std::string toString() const override { return "<binary-expression>"; }
+    void forEachChild(ChildVisitor visit) const override;
+};
+
+class UnaryExpressionNode : public ParseTreeNode {
+public:
+    Token op_token;  // tidak, + or -
+    NodePtr<ParseTreeNode> pars_operand;
+    
+    std::string toString() const override { return "<unary-expression>"; }
+    void forEachChild(ChildVisitor visit) const override;
 };
 
 // Relational Operator Node
@@ -353,7 +402,6 @@ public:
     Token op_token;  // =, <>, <, <=, >, >=
     
     std::string toString() const override { return "<relational-operator>"; }
-    std::vector<ParseTreeNode*> getChildren() const override { return {}; }
 };
 
 // Additive Operator Node
@@ -362,7 +410,6 @@ public:
     Token op_token;  // +, -, atau
     
     std::string toString() const override { return "<additive-operator>"; }
-    std::vector<ParseTreeNode*> getChildren() const override { return {}; }
 };
 
 
@@ -373,7 +420,23 @@ public:
     Token op_token;  // *, /, bagi, mod, dan
     
     std::string toString() const override { return "<multiplicative-operator>"; }
-    std::vector<ParseTreeNode*> getChildren() const override { return {}; }
+};
+
+// A parsed program and the arena its nodes live in. Dropping the tree frees
+// the arena's blocks; no node destructor runs.
+class ParseTree {
+public:
+    ParseTree() = default;
+    ParseTree(std::unique_ptr<NodeArena> arena, ProgramNode* root)
+        : arena(std::move(arena)), root(root) {}
+
+    ProgramNode* get() const { return root; }
+    ProgramNode* operator->() const { return root; }
+    explicit operator bool() const { return root != nullptr; }
+
+private:
+    std::unique_ptr<NodeArena> arena;
+    ProgramNode* root = nullptr;
 };
 
 #endif // PARSE_TREE_NODES_HPP
\ No newline at end of file
@@ -3,7 +3,10 @@
 
 #include "../lexer/token.hpp"
 #include "../lexer/lexer.hpp"
+#include "../lexer/token_buffer.hpp"
 #include "../parser/parse_tree_nodes.hpp"
+#include "../ast/ast.hpp"
+#include <array>
 #include <vector>
 #include <memory>
 #include <string>
@@ -15,57 +18,125 @@ public:
     explicit SyntaxError(const std::string& message) : std::runtime_error(message) {}
 };
 
+struct ParserOptions {
+    // expressions by precedence climbing, as BinaryExpressionNode /
+    // UnaryExpressionNode trees instead of the expression-term-factor chain
+    bool compact_expressions = false;
+};
+
 // Parser Class
 class Parser {
 private:
-    std::vector<Token> tokens;
+    // Token source: a lexer pulled on demand, or an already lexed vector
+    // or buffer. A vector is read in place; the others go through the window.
+    Lexer* lexer = nullptr;
+    const std::vector<Token>* token_vec = nullptr;
+    const TokenBuffer* token_buf = nullptr;
+    size_t buf_pos = 0;
+    size_t line_hint = 0; // token_buf only
+
+    // Sliding window over the stream: enough history for previous() and
+    // error context, enough lookahead for peek().
+    static constexpr size_t WINDOW = 8;
+    std::array<Token, WINDOW> window;
+    size_t pulled = 0;       // tokens taken from the source so far
+    bool exhausted = false;
+
+    // The cursor: an index, and the token it points at (in the window or
+    // the vector). References from peek()/previous() stay valid until the
+    // window has slid past them.
     size_t current_pos;
-    Token current_token;
+    const Token* current;
+
+    bool compact_expressions = false;
+    bool direct_ast = false; // inside ast_program()
     
+    const Token* token_at(size_t pos); // nullptr past the end / out of the window
     void advance();
-    bool match(const std::string& type);
-    bool check(const std::string& type);
-    void expect(const std::string& type, const std::string& message);
-    Token peek(int offset = 1);
-    Token previous();
+    bool match(TokenKind kind);
+    bool check(TokenKind kind);
+    void expect(TokenKind kind, const std::string& message);
+    const Token& peek(int offset = 1);
+    const Token& previous();
+    [[noreturn]] void error_at_current(const std::string& message, const std::string& note);
+    [[noreturn]] void unexpected_in_statement();
+    [[noreturn]] void unexpected_in_expression();
+
+    // every node goes into the arena, which pars_program() hands over to
+    // the ParseTree it returns
+    std::unique_ptr<NodeArena> arena = std::make_unique<NodeArena>();
+    template <class T, class... Args>
+    NodePtr<T> make(Args&&... args) { return NodePtr<T>(arena->make<T>(std::forward<Args>(args)...)); }
     
 public:
-    Parser(const std::vector<Token>& tokens);
+    // Streams tokens from lexer, which must outlive the parser. A LexerError
+    // can surface from any parse call once the lexer reaches end of input.
+    explicit Parser(Lexer& lexer);
+    // tokens is borrowed, not copied
+    explicit Parser(const std::vector<Token>& tokens);
+    // buffer is borrowed too; Tokens are only built as they enter the window
+    explicit Parser(const TokenBuffer& buffer);
+
+    void set_options(const ParserOptions& options) {
+        compact_expressions = options.compact_expressions;
+    }
     
     // Main parsing function
-    std::unique_ptr<ProgramNode> pars_program();
+    ParseTree pars_program();
     
     // Grammar rules
-    std::unique_ptr<ParseTreeNode> pars_program_header();
-    std::unique_ptr<DeclarationPartNode> pars_declaration_part();
-    std::unique_ptr<ConstDeclarationNode> pars_const_declaration();
-    std::unique_ptr<TypeDeclarationNode> pars_type_declaration();
-    std::unique_ptr<VariableDeclarationNode> pars_variable_declaration_part();
-    std::unique_ptr<SubprogramDeclarationNode> pars_subprogram_declaration();
-    std::unique_ptr<ParseTreeNode> pars_array_type();
-    std::unique_ptr<RangeNode> pars_range();
-    std::unique_ptr<ParseTreeNode> pars_procedure_declaration();
-    std::unique_ptr<ParseTreeNode> pars_function_declaration();
-    std::unique_ptr<FormalParameterListNode> pars_formal_parameter_list();
-    std::unique_ptr<ParameterGroupNode> pars_parameter_group();
-    std::unique_ptr<ParseTreeNode> pars_procedure_block();
-    std::unique_ptr<IdentifierListNode> pars_identifier_list();
-    std::unique_ptr<ParseTreeNode> pars_type();
-    std::unique_ptr<CompoundStatementNode> pars_compound_statement();
-    std::unique_ptr<StatementListNode> pars_statement_list();
-    std::unique_ptr<ParseTreeNode> pars_statement();
+    NodePtr<ParseTreeNode> pars_program_header();
+    NodePtr<DeclarationPartNode> pars_declaration_part();
+    NodePtr<ConstDeclarationNode> pars_const_declaration();
+    NodePtr<TypeDeclarationNode> pars_type_declaration();
+    NodePtr<VariableDeclarationNode> pars_variable_declaration_part();
+    NodePtr<SubprogramDeclarationNode> pars_subprogram_declaration();
+    NodePtr<ParseTreeNode> pars_array_type();
+    NodePtr<RangeNode> pars_range();
+    NodePtr<ParseTreeNode> pars_procedure_declaration();
+    NodePtr<ParseTreeNode> pars_function_declaration();
+    NodePtr<FormalParameterListNode> pars_formal_parameter_list();
+    NodePtr<ParameterGroupNode> pars_parameter_group();
+    NodePtr<ParseTreeNode> pars_procedure_block();
+    NodePtr<IdentifierListNode> pars_identifier_list();
+    NodePtr<ParseTreeNode> pars_type();
+    NodePtr<CompoundStatementNode> pars_compound_statement();
+    NodePtr<StatementListNode> pars_statement_list();
+    NodePtr<ParseTreeNode> pars_statement();
+    
+    NodePtr<ParseTreeNode> pars_assignment_statement();
+    NodePtr<ParseTreeNode> pars_procedure_call();
+    NodePtr<ParseTreeNode> pars_if_statement();
+    NodePtr<ParseTreeNode> pars_while_statement();
+    NodePtr<ParseTreeNode> pars_for_statement();
     
-    std::unique_ptr<ParseTreeNode> pars_assignment_statement();
-    std::unique_ptr<ParseTreeNode> pars_procedure_call();
-    std::unique_ptr<ParseTreeNode> pars_if_statement();
-    std::unique_ptr<ParseTreeNode> pars_while_statement();
-    std::unique_ptr<ParseTreeNode> pars_for_statement();
+    NodePtr<ParseTreeNode> pars_expression();
+    NodePtr<ParseTreeNode> pars_simple_expression();
+    NodePtr<ParseTreeNode> pars_term();
+    NodePtr<ParseTreeNode> pars_factor();
+    NodePtr<ProcedureFunctionCallNode> pars_function_call();
+    NodePtr<ParseTreeNode> pars_compact_expression(int min_level);
+    NodePtr<ParseTreeNode> pars_compact_operand();
+    NodePtr<ParseTreeNode> pars_parameter_list();
     
-    std::unique_ptr<ParseTreeNode> pars_expression();
-    std::unique_ptr<ParseTreeNode> pars_simple_expression();
-    std::unique_ptr<ParseTreeNode> pars_term();
-    std::unique_ptr<ParseTreeNode> pars_factor();
-    std::unique_ptr<ParseTreeNode> pars_parameter_list();
+    // Single pass to the AST: the same grammar, but statements and
+    // expressions become AST nodes as they are recognized, with no parse
+    // tree in between. Declarations the AST does not keep (konstanta, tipe,
+    // subprograms) are still checked; subprogram bodies are parsed and
+    // dropped. Expressions come out as with compact_expressions.
+    std::unique_ptr<ASTProgramNode> ast_program();
+    std::unique_ptr<ASTDeclarationListNode> ast_declaration_part();
+    std::unique_ptr<ASTCompoundStmtNode> ast_compound_statement();
+    std::unique_ptr<ASTStatementNode> ast_statement();
+    std::unique_ptr<ASTStatementNode> ast_assignment_statement();
+    std::unique_ptr<ASTStatementNode> ast_procedure_call();
+    std::unique_ptr<ASTStatementNode> ast_if_statement();
+    std::unique_ptr<ASTStatementNode> ast_while_statement();
+    std::unique_ptr<ASTStatementNode> ast_for_statement();
+    std::unique_ptr<ASTExpressionNode> ast_expression();
+    std::unique_ptr<ASTExpressionNode> ast_binary_expression(int min_level);
+    std::unique_ptr<ASTExpressionNode> ast_operand();
+    std::vector<std::unique_ptr<ASTExpressionNode>> ast_argument_list();
 };
 
 #endif // PARSER_HPP
@@ -27,8 +27,8 @@ private:
     // Helper methods
     BaseType getBaseType(const std::string& typeStr);
     int getTypeSize(BaseType type);
-    bool isDeclaredInCurrentScope(const std::string& identifier);
-    int lookupIdentifier(const std::string& identifier);
+    bool isDeclaredInCurrentScope(Atom identifier);
+    int lookupIdentifier(Atom identifier);
     BaseType inferTypeFromValue(const std::string& value);
     int processArrayType(const ArrayTypeNode* arrayDef);
 
@@ -54,6 +54,8 @@ public:
     BaseType visitSimpleExpression(ParseTreeNode* node);
     BaseType visitTerm(ParseTreeNode* node);
     BaseType visitFactor(ParseTreeNode* node);
+    BaseType visitBinaryExpression(BinaryExpressionNode* node);
+    BaseType visitOperand(const Token& token); // literal or identifier
     std::string typeToString(BaseType type);
     
     // Getters
@@ -5,6 +5,7 @@
 #include <vector>
 #include <unordered_map>
 #include <stdexcept>
+#include "../lexer/interner.hpp"
 
 enum class ObjectKind {
     CONSTANT,
@@ -25,7 +26,7 @@ enum class BaseType {
 };
 
 struct TabEntry {
-    std::string name;
+    Atom name; // interned, so scope chains compare integers
     int link;
     ObjectKind obj;
     BaseType typ;
@@ -64,6 +65,11 @@ public:
     void init_standard_types();
     void init_standard_procedures();
     
+    int insert(Atom name, ObjectKind obj, BaseType typ, int ref, bool normal, int adr);
+    int lookup(Atom name);
+    int lookup_current_scope(Atom name);
+
+    // by spelling; a name that was never interned cannot be in the table
     int insert(const std::string& name, ObjectKind obj, BaseType typ, int ref, bool normal, int adr);
     int lookup(const std::string& name);
     int lookup_current_scope(const std::string& name);
@@ -96,6 +102,7 @@ private:
     std::vector<ATabEntry> atab;
     
     std::vector<int> display;
+    std::vector<Atom> std_procs; // write, writeln, read, readln
     int level;
     
     int t;
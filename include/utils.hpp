@@ -5,7 +5,9 @@
 class Utils{
     public:
         static std::string resolve_from_here(const std::string& p);
-        static void print_token(const std::string& type, const std::string& value, const std::string& prefix, bool is_last);
+        static void print_token(std::string_view type, std::string_view value, const std::string& prefix, bool is_last);
         static void print_parse_tree(const ParseTreeNode* node, const std::string& prefix = "", bool is_last = true, bool is_root = true);
+    private:
+        static void print_tree(const ParseTreeNode* node, std::string& prefix, bool is_last, bool is_root);
     };
     
\ No newline at end of file
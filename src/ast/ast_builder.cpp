@@ -1,6 +1,11 @@
 #include "ast/ast_builder.hpp"
 #include <stdexcept>
 
+// call targets may be keyword tokens, which carry no atom
+static Atom name_atom(const Token& token) {
+    return token.atom != NO_ATOM ? token.atom : intern(token.value);
+}
+
 std::unique_ptr<ASTProgramNode> ASTBuilder::buildAST(const ProgramNode* parse_tree) {
     if (!parse_tree) {
         throw std::runtime_error("parse tree is null");
@@ -99,7 +104,7 @@ std::unique_ptr<ASTStatementNode> ASTBuilder::translateStatement(const ParseTree
 std::unique_ptr<ASTAssignmentNode> ASTBuilder::translateAssignment(const AssignmentStatementNode* node) {
     auto assignment = std::make_unique<ASTAssignmentNode>();
     
-    assignment->variable_name = node->identifier.value;
+    assignment->variable_name = node->identifier.atom;
     
     if (node->pars_expression) {
         assignment->expression = translateExpression(node->pars_expression.get());
@@ -143,7 +148,7 @@ std::unique_ptr<ASTWhileNode> ASTBuilder::translateWhile(const WhileStatementNod
 std::unique_ptr<ASTForNode> ASTBuilder::translateFor(const ForStatementNode* node) {
     auto for_node = std::make_unique<ASTForNode>();
     
-    for_node->control_var = node->control_variable.value;
+    for_node->control_var = node->control_variable.atom;
     
     if (node->pars_initial_value) {
         for_node->initial_value = translateExpression(node->pars_initial_value.get());
@@ -153,7 +158,7 @@ std::unique_ptr<ASTForNode> ASTBuilder::translateFor(const ForStatementNode* nod
         for_node->final_value = translateExpression(node->pars_final_value.get());
     }
     
-    for_node->is_downto = (node->direction_keyword.value == "turun-ke");
+    for_node->is_downto = (node->direction_keyword.kind == TokenKind::KW_TURUN_KE);
     
     if (node->pars_body) {
         for_node->body = translateStatement(node->pars_body.get());
@@ -165,7 +170,7 @@ std::unique_ptr<ASTForNode> ASTBuilder::translateFor(const ForStatementNode* nod
 std::unique_ptr<ASTProcedureCallNode> ASTBuilder::translateProcedureCall(const ProcedureFunctionCallNode* node) {
     auto proc_call = std::make_unique<ASTProcedureCallNode>();
     
-    proc_call->procedure_name = node->procedure_name.value;
+    proc_call->procedure_name = name_atom(node->procedure_name);
     
     if (node->pars_parameter_list) {
         if (auto* param_list = dynamic_cast<const ParameterListNode*>(node->pars_parameter_list.get())) {
@@ -204,6 +209,30 @@ std::unique_ptr<ASTExpressionNode> ASTBuilder::translateExpression(const ParseTr
         return translateSimpleExpression(simple_expr);
     }
     
+    // compact expression trees (ParserOptions::compact_expressions)
+    if (auto* binary = dynamic_cast<const BinaryExpressionNode*>(node)) {
+        auto binary_op = std::make_unique<ASTBinaryOpNode>();
+        binary_op->left = translateExpression(binary->pars_left.get());
+        binary_op->right = translateExpression(binary->pars_right.get());
+        binary_op->op = binary->op_token.value;
+        return binary_op;
+    }
+    
+    if (auto* unary = dynamic_cast<const UnaryExpressionNode*>(node)) {
+        auto unary_op = std::make_unique<ASTUnaryOpNode>();
+        unary_op->op = unary->op_token.value;
+        unary_op->operand = translateExpression(unary->pars_operand.get());
+        return unary_op;
+    }
+    
+    if (auto* operand = dynamic_cast<const TokenNode*>(node)) {
+        return translateOperand(operand->token);
+    }
+    
+    if (auto* call = dynamic_cast<const ProcedureFunctionCallNode*>(node)) {
+        return translateFunctionCall(call);
+    }
+    
     return nullptr;
 }
 
@@ -268,23 +297,7 @@ std::unique_ptr<ASTExpressionNode> ASTBuilder::translateFactor(const FactorNode*
     }
     
     if (node->pars_procedure_function_call) {
-        auto func_call = std::make_unique<ASTFunctionCallNode>();
-        auto* call_node = dynamic_cast<const ProcedureFunctionCallNode*>(node->pars_procedure_function_call.get());
-        
-        func_call->function_name = call_node->procedure_name.value;
-        
-        if (call_node->pars_parameter_list) {
-            if (auto* param_list = dynamic_cast<const ParameterListNode*>(call_node->pars_parameter_list.get())) {
-                for (const auto& param : param_list->pars_parameters) {
-                    auto arg = translateExpression(param.get());
-                    if (arg) {
-                        func_call->arguments.push_back(std::move(arg));
-                    }
-                }
-            }
-        }
-        
-        return func_call;
+        return translateFunctionCall(node->pars_procedure_function_call.get());
     }
     
     if (node->pars_expression) {
@@ -292,47 +305,63 @@ std::unique_ptr<ASTExpressionNode> ASTBuilder::translateFactor(const FactorNode*
     }
     
     if (!node->token.value.empty()) {
-        if (node->token.type == "IDENTIFIER") {
-            auto identifier = std::make_unique<ASTIdentifierNode>();
-            identifier->name = node->token.value;
-            return identifier;
-        }
-        else {
-            auto literal = std::make_unique<ASTLiteralNode>();
-            literal->value = node->token.value;
-            literal->literal_type = getLiteralType(node->token);
-            return literal;
-        }
+        return translateOperand(node->token);
     }
     
     return nullptr;
 }
 
-std::vector<std::string> ASTBuilder::extractIdentifiers(const IdentifierListNode* node) {
-    std::vector<std::string> identifiers;
+std::unique_ptr<ASTExpressionNode> ASTBuilder::translateOperand(const Token& token) {
+    if (token.kind == TokenKind::IDENTIFIER) {
+        auto identifier = std::make_unique<ASTIdentifierNode>();
+        identifier->name = token.atom;
+        return identifier;
+    }
     
-    for (const auto& token : node->identifier_tokens) {
-        identifiers.push_back(token.value);
+    auto literal = std::make_unique<ASTLiteralNode>();
+    literal->value = token.value;
+    literal->literal_type = getLiteralType(token);
+    return literal;
+}
+
+std::unique_ptr<ASTExpressionNode> ASTBuilder::translateFunctionCall(const ProcedureFunctionCallNode* node) {
+    auto func_call = std::make_unique<ASTFunctionCallNode>();
+    
+    func_call->function_name = name_atom(node->procedure_name);
+    
+    if (node->pars_parameter_list) {
+        if (auto* param_list = dynamic_cast<const ParameterListNode*>(node->pars_parameter_list.get())) {
+            for (const auto& param : param_list->pars_parameters) {
+                auto arg = translateExpression(param.get());
+                if (arg) {
+                    func_call->arguments.push_back(std::move(arg));
+                }
+            }
+        }
     }
     
-    return identifiers;
+    return func_call;
+}
+
+std::vector<Atom> ASTBuilder::extractIdentifiers(const IdentifierListNode* node) {
+    return std::vector<Atom>(node->pars_identifier_list.begin(), node->pars_identifier_list.end());
 }
 
 std::string ASTBuilder::getLiteralType(const Token& token) {
-    if (token.type == "NUMBER") {
+    if (token.kind == TokenKind::NUMBER) {
         // desimal ga
         if (token.value.find('.') != std::string::npos) {
             return "real";
         }
         return "integer";
     }
-    else if (token.type == "STRING_LITERAL") {
+    else if (token.kind == TokenKind::STRING_LITERAL) {
         return "string";
     }
-    else if (token.type == "CHAR_LITERAL") {
+    else if (token.kind == TokenKind::CHAR_LITERAL) {
         return "char";
     }
-    else if (token.type == "KEYWORD") {
+    else if (is_keyword(token.kind)) {
         // bool benar/salah
         if (token.value == "benar" || token.value == "salah") {
             return "boolean";
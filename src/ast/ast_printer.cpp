@@ -40,7 +40,7 @@ void ASTPrinter::visitVarDecl(ASTVarDeclNode* node) {
     
     // print identifiers
     for (size_t i = 0; i < node->identifiers.size(); i++) {
-        out_ << node->identifiers[i];
+        out_ << atom_name(node->identifiers[i]);
         if (i < node->identifiers.size() - 1) out_ << ", ";
     }
     
@@ -60,7 +60,7 @@ void ASTPrinter::visitCompoundStmt(ASTCompoundStmtNode* node) {
 
 void ASTPrinter::visitAssignment(ASTAssignmentNode* node) {
     printIndent();
-    out_ << "Assignment: " << node->variable_name << " := \n";
+    out_ << "Assignment: " << atom_name(node->variable_name) << " := \n";
     
     increaseIndent();
     if (node->expression) {
@@ -129,7 +129,7 @@ void ASTPrinter::visitWhile(ASTWhileNode* node) {
 
 void ASTPrinter::visitFor(ASTForNode* node) {
     printIndent();
-    out_ << "For: " << node->control_var << " := \n";
+    out_ << "For: " << atom_name(node->control_var) << " := \n";
     
     increaseIndent();
     
@@ -162,7 +162,7 @@ void ASTPrinter::visitFor(ASTForNode* node) {
 
 void ASTPrinter::visitProcedureCall(ASTProcedureCallNode* node) {
     printIndent();
-    out_ << "ProcedureCall: " << node->procedure_name << "\n";
+    out_ << "ProcedureCall: " << atom_name(node->procedure_name) << "\n";
     
     if (!node->arguments.empty()) {
         increaseIndent();
@@ -220,12 +220,12 @@ void ASTPrinter::visitLiteral(ASTLiteralNode* node) {
 
 void ASTPrinter::visitIdentifier(ASTIdentifierNode* node) {
     printIndent();
-    out_ << "Identifier: " << node->name << "\n";
+    out_ << "Identifier: " << atom_name(node->name) << "\n";
 }
 
 void ASTPrinter::visitFunctionCall(ASTFunctionCallNode* node) {
     printIndent();
-    out_ << "FunctionCall: " << node->function_name << "\n";
+    out_ << "FunctionCall: " << atom_name(node->function_name) << "\n";
     
     if (!node->arguments.empty()) {
         increaseIndent();
@@ -122,7 +122,7 @@ void ASTDecoratedPrinter::visitVarDecl(ASTVarDeclNode *node)
             out_ << "├─ ";
         }
 
-        out_ << "VarDecl('" << node->identifiers[i] << "')";
+        out_ << "VarDecl('" << atom_name(node->identifiers[i]) << "')";
 
         // Add annotation
         int idx = symTab_->lookup(node->identifiers[i]);
@@ -158,7 +158,7 @@ void ASTDecoratedPrinter::visitCompoundStmt(ASTCompoundStmtNode *node)
 
 void ASTDecoratedPrinter::visitAssignment(ASTAssignmentNode *node)
 {
-    out_ << "Assign('" << node->variable_name << "' := ...)";
+    out_ << "Assign('" << atom_name(node->variable_name) << "' := ...)";
 
     // Add type annotation for assignment
     int idx = symTab_->lookup(node->variable_name);
@@ -177,7 +177,7 @@ void ASTDecoratedPrinter::visitAssignment(ASTAssignmentNode *node)
 
     // Print target
     printIndent();
-    out_ << "├─ target '" << node->variable_name << "'";
+    out_ << "├─ target '" << atom_name(node->variable_name) << "'";
     idx = symTab_->lookup(node->variable_name);
     if (idx != -1)
     {
@@ -284,7 +284,7 @@ void ASTDecoratedPrinter::visitWhile(ASTWhileNode *node)
 
 void ASTDecoratedPrinter::visitFor(ASTForNode *node)
 {
-    out_ << "For('" << node->control_var << "')\n";
+    out_ << "For('" << atom_name(node->control_var) << "')\n";
 
     increaseIndent();
 
@@ -327,7 +327,7 @@ void ASTDecoratedPrinter::visitFor(ASTForNode *node)
 
 void ASTDecoratedPrinter::visitProcedureCall(ASTProcedureCallNode *node)
 {
-    out_ << node->procedure_name << "(...)";
+    out_ << atom_name(node->procedure_name) << "(...)";
 
     // Add annotation
     int idx = symTab_->lookup(node->procedure_name);
@@ -431,7 +431,7 @@ void ASTDecoratedPrinter::visitLiteral(ASTLiteralNode *node)
 
 void ASTDecoratedPrinter::visitIdentifier(ASTIdentifierNode *node)
 {
-    out_ << "'" << node->name << "'";
+    out_ << "'" << atom_name(node->name) << "'";
 
     // Add annotation
     int idx = symTab_->lookup(node->name);
@@ -446,7 +446,7 @@ void ASTDecoratedPrinter::visitIdentifier(ASTIdentifierNode *node)
 
 void ASTDecoratedPrinter::visitFunctionCall(ASTFunctionCallNode *node)
 {
-    out_ << node->function_name << "(...)";
+    out_ << atom_name(node->function_name) << "(...)";
 
     // Add annotation
     int idx = symTab_->lookup(node->function_name);
@@ -1,8 +1,13 @@
 #include "lexer/dfa_loader.hpp"
+#include "lexer/char_classes.hpp"
+#include "lexer/source_buffer.hpp"
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
 #include <cctype>
+#include <map>
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
@@ -13,6 +18,253 @@ std::string DFA::next_state(const std::string& state, const std::string& inp) co
     return it->second;
 }
 
+ScanMatch CompiledDFA::scan(std::string_view src, size_t from) const {
+    ScanMatch m{DEAD, from, from};
+    size_t i = from;
+    int state = start_state;
+    while (i < src.size()) {
+        int nxt = next(state, static_cast<unsigned char>(src[i]));
+        if (nxt == DEAD) break;
+        ++i;
+        state = nxt;
+        if (is_final(state)) {
+            m.state = state;
+            m.end = i;
+        }
+    }
+    m.stop = i;
+    return m;
+}
+
+namespace {
+// Owned backing arrays for a CompiledDFA built at runtime
+struct CompiledTables {
+    std::vector<std::string> names;
+    std::vector<std::string_view> name_views;
+    std::vector<unsigned char> finals;
+    std::vector<int> table;
+};
+}
+
+CompiledDFA DFA::compile() const {
+    // collect every state name; start gets id 0, the rest are sorted for stable ids
+    std::map<std::string, int> ids;
+    std::vector<std::string> names;
+    auto intern = [&](const std::string& s) {
+        if (ids.emplace(s, static_cast<int>(names.size())).second) names.push_back(s);
+    };
+    intern(start_state);
+    std::map<std::string, int> others;
+    for (const auto& f : final_states) others.emplace(f, 0);
+    for (const auto& kv : transitions) {
+        others.emplace(kv.first.first, 0);
+        others.emplace(kv.second, 0);
+    }
+    for (const auto& kv : others) intern(kv.first);
+
+    auto out = std::make_shared<CompiledTables>();
+    out->names = names;
+    out->name_views.assign(out->names.begin(), out->names.end());
+    out->finals.assign(names.size(), 0);
+    out->table.assign(names.size() * 256, CompiledDFA::DEAD);
+    for (const auto& f : final_states) out->finals[ids[f]] = 1;
+
+    for (size_t s = 0; s < names.size(); ++s) {
+        const std::string& state = names[s];
+        auto resolve = [&](char c) -> std::string {
+            // 1) exact char
+            std::string nxt = next_state(state, std::string(1, c));
+            if (!nxt.empty()) return nxt;
+            // 2) char classes
+            unsigned char mask = char_class_mask(c);
+            for (const auto& cls : CHAR_CLASS_NAMES) {
+                if (!(mask & cls.bit)) continue;
+                nxt = next_state(state, cls.name);
+                if (!nxt.empty()) return nxt;
+            }
+            // 3) alnum or underscore
+            if (mask & (CC_LETTER | CC_DIGIT | CC_UNDERSCORE)) {
+                nxt = next_state(state, "letter_or_digit_or_underscore");
+                if (!nxt.empty()) return nxt;
+            }
+            // 4) wildcard any
+            nxt = next_state(state, "any");
+            if (!nxt.empty()) return nxt;
+            // any_non_quote untuk di dalam string/char
+            if (c != '\'') return next_state(state, "any_non_quote");
+            return std::string();
+        };
+        // byte 0 stays DEAD: the lexer treats NUL as end of input
+        for (int b = 1; b < 256; ++b) {
+            std::string nxt = resolve(static_cast<char>(b));
+            if (!nxt.empty()) out->table[s * 256 + b] = ids[nxt];
+        }
+    }
+    const CompiledTables& t = *out;
+    return CompiledDFA(0, names.size(), t.name_views.data(), t.finals.data(), t.table.data(), std::move(out));
+}
+
+CompiledDFA minimize_dfa(const CompiledDFA& dfa, DFAReport* report) {
+    const int n = static_cast<int>(dfa.size());
+    const int sink = n; // stands in for DEAD so a missing transition is a state of its own
+    auto step = [&](int s, int c) {
+        if (s == sink) return sink;
+        int t = dfa.next(s, static_cast<unsigned char>(c));
+        return t == CompiledDFA::DEAD ? sink : t;
+    };
+
+    // reachable from start
+    std::vector<char> reachable(n, 0);
+    std::vector<int> stack{dfa.start()};
+    reachable[dfa.start()] = 1;
+    while (!stack.empty()) {
+        int s = stack.back();
+        stack.pop_back();
+        for (int c = 0; c < 256; ++c) {
+            int t = dfa.next(s, static_cast<unsigned char>(c));
+            if (t != CompiledDFA::DEAD && !reachable[t]) {
+                reachable[t] = 1;
+                stack.push_back(t);
+            }
+        }
+    }
+
+    // reverse edges, then which states can still reach a final one
+    std::vector<std::vector<std::vector<int>>> inv(256, std::vector<std::vector<int>>(n + 1));
+    for (int s = 0; s <= n; ++s) {
+        if (s < n && !reachable[s]) continue;
+        for (int c = 0; c < 256; ++c) inv[c][step(s, c)].push_back(s);
+    }
+    std::vector<char> live(n, 0);
+    for (int s = 0; s < n; ++s) {
+        if (reachable[s] && dfa.is_final(s)) {
+            live[s] = 1;
+            stack.push_back(s);
+        }
+    }
+    while (!stack.empty()) {
+        int t = stack.back();
+        stack.pop_back();
+        for (int c = 0; c < 256; ++c)
+            for (int s : inv[c][t])
+                if (s != sink && !live[s]) {
+                    live[s] = 1;
+                    stack.push_back(s);
+                }
+    }
+
+    DFAReport rep;
+    rep.states_before = dfa.size();
+    for (int s = 0; s < n; ++s) {
+        if (!reachable[s]) rep.unreachable.emplace_back(dfa.name(s));
+        else if (!live[s]) rep.dead.emplace_back(dfa.name(s));
+    }
+
+    // initial partition: sink | non-final | one block per final name
+    std::vector<int> block_of(n + 1, -1);
+    std::vector<std::vector<int>> blocks;
+    std::map<std::string_view, int> final_block;
+    auto new_block = [&]() { blocks.emplace_back(); return static_cast<int>(blocks.size()) - 1; };
+    const int sink_block = new_block();
+    const int nonfinal_block = new_block();
+    block_of[sink] = sink_block;
+    blocks[sink_block].push_back(sink);
+    for (int s = 0; s < n; ++s) {
+        if (!reachable[s]) continue;
+        int b = nonfinal_block;
+        if (dfa.is_final(s)) {
+            auto it = final_block.find(dfa.name(s));
+            if (it == final_block.end()) it = final_block.emplace(dfa.name(s), new_block()).first;
+            b = it->second;
+        }
+        block_of[s] = b;
+        blocks[b].push_back(s);
+    }
+
+    // Hopcroft refinement over (splitter block, byte) pairs
+    std::vector<std::vector<char>> queued;
+    std::vector<std::pair<int, int>> work;
+    auto enqueue = [&](int b, int c) {
+        if (queued[b][c]) return;
+        queued[b][c] = 1;
+        work.emplace_back(b, c);
+    };
+    queued.assign(blocks.size(), std::vector<char>(256, 0));
+    for (int b = 0; b < static_cast<int>(blocks.size()); ++b)
+        if (!blocks[b].empty())
+            for (int c = 0; c < 256; ++c) enqueue(b, c);
+
+    std::vector<char> in_pre(n + 1, 0);
+    while (!work.empty()) {
+        auto [a, c] = work.back();
+        work.pop_back();
+        queued[a][c] = 0;
+
+        // states that step into block a on byte c
+        std::vector<int> pre;
+        for (int t : blocks[a])
+            for (int s : inv[c][t])
+                if (!in_pre[s]) {
+                    in_pre[s] = 1;
+                    pre.push_back(s);
+                }
+
+        std::map<int, std::vector<int>> hit; // block -> its members in pre
+        for (int s : pre) hit[block_of[s]].push_back(s);
+        for (auto& [y, inside] : hit) {
+            if (inside.size() == blocks[y].size()) continue;
+            std::vector<int> outside;
+            for (int s : blocks[y])
+                if (!in_pre[s]) outside.push_back(s);
+            int z = new_block();
+            queued.emplace_back(256, 0);
+            // the smaller half moves to the new block
+            std::vector<int>& moved = inside.size() <= outside.size() ? inside : outside;
+            blocks[y] = inside.size() <= outside.size() ? outside : inside;
+            blocks[z] = moved;
+            for (int s : blocks[z]) block_of[s] = z;
+            for (int cc = 0; cc < 256; ++cc) {
+                if (queued[y][cc]) enqueue(z, cc);
+                else enqueue(blocks[y].size() <= blocks[z].size() ? y : z, cc);
+            }
+        }
+        for (int s : pre) in_pre[s] = 0;
+    }
+
+    // number blocks: start's block first, then by lowest original state id
+    std::vector<int> new_id(blocks.size(), -1);
+    std::vector<int> rep_state;
+    auto number = [&](int s) {
+        int b = block_of[s];
+        if (new_id[b] < 0) {
+            new_id[b] = static_cast<int>(rep_state.size());
+            rep_state.push_back(s);
+        }
+    };
+    number(dfa.start());
+    for (int s = 0; s < n; ++s)
+        if (reachable[s]) number(s);
+
+    auto out = std::make_shared<CompiledTables>();
+    const size_t m = rep_state.size();
+    for (int s : rep_state) {
+        out->names.emplace_back(dfa.name(s));
+        out->finals.push_back(dfa.is_final(s) ? 1 : 0);
+    }
+    out->name_views.assign(out->names.begin(), out->names.end());
+    out->table.assign(m * 256, CompiledDFA::DEAD);
+    for (size_t k = 0; k < m; ++k)
+        for (int c = 0; c < 256; ++c) {
+            int t = step(rep_state[k], c);
+            if (t != sink) out->table[k * 256 + c] = new_id[block_of[t]];
+        }
+
+    rep.states_after = m;
+    if (report) *report = std::move(rep);
+    const CompiledTables& t = *out;
+    return CompiledDFA(0, m, t.name_views.data(), t.finals.data(), t.table.data(), std::move(out));
+}
+
 DFA load_dfa_txt(const std::string& path) {
     std::ifstream f(path);
     if (!f) throw std::runtime_error("Cannot open DFA txt: " + path);
@@ -80,3 +332,137 @@ DFA load_dfa_json(const std::string& path) {
     }
     return DFA(start_state, finals, trans);
 }
+
+// ---- binary format ----
+//
+//   DfaBinHeader
+//   uint32 name_offsets[num_states + 1]   (into the name pool)
+//   char   name_pool[]                    (each state name stored once)
+//   uint8  final_bitmap[(num_states + 7) / 8]
+//   padding to a multiple of 4
+//   int32  table[num_states * 256]        (next state id or -1)
+namespace {
+constexpr char DFA_BIN_MAGIC[4] = {'P', 'D', 'F', 'A'};
+constexpr uint32_t DFA_BIN_VERSION = 1;
+
+struct DfaBinHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t num_states;
+    uint32_t start_state;
+    uint32_t names_offset; // byte offsets from the start of the file
+    uint32_t pool_offset;
+    uint32_t finals_offset;
+    uint32_t table_offset;
+};
+
+static_assert(sizeof(int) == sizeof(int32_t), "table entries are stored as int32");
+
+// Mapped file plus the small arrays rebuilt from it; the table itself is
+// used straight from the mapping.
+struct MappedTables {
+    SourceBuffer file;
+    std::vector<std::string_view> names;
+    std::vector<unsigned char> finals;
+    std::vector<int> table_copy; // only if the mapping is misaligned
+};
+
+size_t align4(size_t n) { return (n + 3) & ~static_cast<size_t>(3); }
+}
+
+CompiledDFA load_dfa_bin(const std::string& path) {
+    auto out = std::make_shared<MappedTables>();
+    try {
+        out->file = SourceBuffer::open(path);
+    } catch (const std::exception&) {
+        throw std::runtime_error("Cannot open DFA binary: " + path);
+    }
+    std::string_view bytes = out->file.view();
+    auto bad = [&](const std::string& why) { return std::runtime_error("Invalid DFA binary " + path + ": " + why); };
+
+    DfaBinHeader h;
+    if (bytes.size() < sizeof h) throw bad("truncated header");
+    std::memcpy(&h, bytes.data(), sizeof h);
+    if (std::memcmp(h.magic, DFA_BIN_MAGIC, sizeof h.magic) != 0) throw bad("bad magic");
+    if (h.version != DFA_BIN_VERSION) throw bad("unsupported version " + std::to_string(h.version));
+
+    const size_t n = h.num_states;
+    if (n == 0 || h.start_state >= n) throw bad("bad start state");
+    const size_t names_end = static_cast<size_t>(h.names_offset) + (n + 1) * sizeof(uint32_t);
+    const size_t table_bytes = n * 256 * sizeof(int32_t);
+    if (names_end > bytes.size() || h.pool_offset > bytes.size() ||
+        static_cast<size_t>(h.finals_offset) + (n + 7) / 8 > bytes.size() ||
+        h.table_offset % 4 != 0 || static_cast<size_t>(h.table_offset) + table_bytes > bytes.size())
+        throw bad("section out of range");
+
+    // names
+    std::vector<uint32_t> offs(n + 1);
+    std::memcpy(offs.data(), bytes.data() + h.names_offset, (n + 1) * sizeof(uint32_t));
+    const size_t pool_size = bytes.size() - h.pool_offset;
+    out->names.reserve(n);
+    for (size_t s = 0; s < n; ++s) {
+        if (offs[s] > offs[s + 1] || offs[s + 1] > pool_size) throw bad("bad name offsets");
+        out->names.emplace_back(bytes.data() + h.pool_offset + offs[s], offs[s + 1] - offs[s]);
+    }
+
+    // final bitmap -> one byte per state
+    out->finals.resize(n);
+    const unsigned char* bitmap = reinterpret_cast<const unsigned char*>(bytes.data() + h.finals_offset);
+    for (size_t s = 0; s < n; ++s) out->finals[s] = (bitmap[s / 8] >> (s % 8)) & 1;
+
+    // table: in place when aligned (always, for a mapping)
+    const char* raw = bytes.data() + h.table_offset;
+    const int* table = reinterpret_cast<const int*>(raw);
+    if (reinterpret_cast<uintptr_t>(raw) % alignof(int) != 0) {
+        out->table_copy.resize(n * 256);
+        std::memcpy(out->table_copy.data(), raw, table_bytes);
+        table = out->table_copy.data();
+    }
+    for (size_t k = 0; k < n * 256; ++k) {
+        if (table[k] < CompiledDFA::DEAD || table[k] >= static_cast<int>(n)) throw bad("transition out of range");
+    }
+
+    const MappedTables& t = *out;
+    return CompiledDFA(static_cast<int>(h.start_state), n, t.names.data(), t.finals.data(), table, std::move(out));
+}
+
+void save_dfa_bin(const CompiledDFA& dfa, const std::string& path) {
+    const size_t n = dfa.size();
+
+    std::vector<uint32_t> offs;
+    std::string pool;
+    for (size_t s = 0; s < n; ++s) {
+        offs.push_back(static_cast<uint32_t>(pool.size()));
+        pool += dfa.name(static_cast<int>(s));
+    }
+    offs.push_back(static_cast<uint32_t>(pool.size()));
+
+    std::vector<unsigned char> bitmap((n + 7) / 8, 0);
+    for (size_t s = 0; s < n; ++s)
+        if (dfa.is_final(static_cast<int>(s))) bitmap[s / 8] |= static_cast<unsigned char>(1u << (s % 8));
+
+    DfaBinHeader h;
+    std::memcpy(h.magic, DFA_BIN_MAGIC, sizeof h.magic);
+    h.version = DFA_BIN_VERSION;
+    h.num_states = static_cast<uint32_t>(n);
+    h.start_state = static_cast<uint32_t>(dfa.start());
+    h.names_offset = sizeof h;
+    h.pool_offset = h.names_offset + static_cast<uint32_t>(offs.size() * sizeof(uint32_t));
+    h.finals_offset = h.pool_offset + static_cast<uint32_t>(pool.size());
+    h.table_offset = static_cast<uint32_t>(align4(h.finals_offset + bitmap.size()));
+
+    std::ofstream f(path, std::ios::binary);
+    if (!f) throw std::runtime_error("Cannot write DFA binary: " + path);
+    f.write(reinterpret_cast<const char*>(&h), sizeof h);
+    f.write(reinterpret_cast<const char*>(offs.data()), offs.size() * sizeof(uint32_t));
+    f.write(pool.data(), pool.size());
+    f.write(reinterpret_cast<const char*>(bitmap.data()), bitmap.size());
+    const char pad[4] = {0, 0, 0, 0};
+    f.write(pad, h.table_offset - (h.finals_offset + bitmap.size()));
+    for (size_t s = 0; s < n; ++s) {
+        int32_t row[256];
+        for (int b = 0; b < 256; ++b) row[b] = dfa.next(static_cast<int>(s), static_cast<unsigned char>(b));
+        f.write(reinterpret_cast<const char*>(row), sizeof row);
+    }
+    if (!f) throw std::runtime_error("Cannot write DFA binary: " + path);
+}
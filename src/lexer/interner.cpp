@@ -0,0 +1,72 @@
+#include "lexer/interner.hpp"
+#include <cstring>
+
+uint32_t Interner::hash(std::string_view name) {
+    uint32_t h = 2166136261u; // FNV-1a
+    for (char c : name) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// slot holding name, or the empty slot where it would go
+size_t Interner::slot_of(std::string_view name, uint32_t h) const {
+    size_t mask = slots.size() - 1;
+    for (size_t k = h & mask;; k = (k + 1) & mask) {
+        Atom a = slots[k];
+        if (a == NO_ATOM || (hashes[a] == h && names[a] == name)) return k;
+    }
+}
+
+void Interner::grow() {
+    std::vector<Atom> old = std::move(slots);
+    slots.assign(old.empty() ? 1024 : old.size() * 2, NO_ATOM);
+    size_t mask = slots.size() - 1;
+    for (Atom a : old) {
+        if (a == NO_ATOM) continue;
+        size_t k = hashes[a] & mask;
+        while (slots[k] != NO_ATOM) k = (k + 1) & mask;
+        slots[k] = a;
+    }
+}
+
+Atom Interner::intern(std::string_view name) {
+    if (slots.empty()) grow();
+    uint32_t h = hash(name);
+    size_t k = slot_of(name, h);
+    if (slots[k] != NO_ATOM) return slots[k];
+
+    // copy the text into the current block (a long name gets its own)
+    char* dst = nullptr;
+    if (name.size() > BLOCK) {
+        blocks.emplace_back(new char[name.size()]);
+        dst = blocks.back().get();
+        block_left = 0;
+    } else if (!name.empty()) {
+        if (name.size() > block_left) {
+            blocks.emplace_back(new char[BLOCK]);
+            block_left = BLOCK;
+        }
+        dst = blocks.back().get() + (BLOCK - block_left);
+        block_left -= name.size();
+    }
+    if (dst) std::memcpy(dst, name.data(), name.size());
+
+    Atom atom = static_cast<Atom>(names.size());
+    names.emplace_back(dst, name.size());
+    hashes.push_back(h);
+    slots[k] = atom;
+    if (names.size() * 2 > slots.size()) grow(); // keep the load under 1/2
+    return atom;
+}
+
+Atom Interner::find(std::string_view name) const {
+    if (slots.empty()) return NO_ATOM;
+    return slots[slot_of(name, hash(name))];
+}
+
+Interner& Interner::global() {
+    static Interner pool;
+    return pool;
+}
@@ -1,71 +1,56 @@
 #include "lexer/lexer.hpp"
-#include <sstream>
-#include <cctype>
-#include <unordered_map>
+#include "lexer/interner.hpp"
+#include "lexer/reserved_words.hpp"
+#include "lexer/simd_scan.hpp"
+#include <algorithm>
+#include <limits>
+#include <thread>
 
-#include <sstream>
-#include <cctype>
-
-char Lexer::peek(int k) const {
-    size_t idx = i + (k < 0 ? 0 : static_cast<size_t>(k));
-    if (idx < src.size()) return src[idx];
+char Lexer::at(size_t k) const {
+    if (k < src.size()) return src[k];
     return 0; // acts like None
 }
 
-char Lexer::advance() {
-    if (i >= src.size()) return 0;
-    char ch = src[i++];
-    if (ch == '\n') { line++; col = 1; }
-    else { col++; }
-    return ch;
-}
-
-void Lexer::skip_ws_comment(std::vector<std::string>& errors) {
+void Lexer::skip_ws_comment(size_t& pos, std::vector<LexDiagnostic>& errs) const {
+    const char* p = src.data();
+    const size_t n = src.size();
     while (true) {
-        char ch = peek();
+        char ch = at(pos);
         if (!ch) return;
 
         // whitespace
-        if (ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n') {
-            advance();
+        if (char_class_mask(ch) & (CC_WHITESPACE | CC_NEWLINE)) {
+            pos = skip_blanks(p, pos, n);
             continue;
         }
-        // { ... } comment
+        // { ... } comment; a NUL byte ends it like end of input
         if (ch == '{') {
-            int start_line = line, start_col = col;
-            advance();
-            bool terminated = false;
-            while (true) {
-                char n = advance();
-                if (!n) { 
-                    std::ostringstream oss;
-                    oss << "Unterminated { ... } comment at line " << start_line << ", col " << start_col; 
-                    errors.push_back(oss.str());
-                    break;  // Exit loop and continue lexing
-                } 
-                if (n == '}') {
-                    terminated = true;
-                    break;
-                }
+            size_t start = pos;
+            size_t j = find_either(p, pos + 1, n, '}', '\0');
+            if (j < n && p[j] == '}') {
+                pos = j + 1;
+                continue;
             }
-            continue;
+            pos = j < n ? j + 1 : n; // past the NUL, if any
+            errs.push_back(LexDiagnostic{LexErrorCode::UNTERMINATED_BRACE_COMMENT, static_cast<uint32_t>(start),
+                                         static_cast<uint32_t>(pos - start)});
+            continue;  // continue lexing
         }
         // (* ... *) comment
-        if (ch == '(' && peek(1) == '*') {
-            int start_line = line, start_col = col;
-            advance(); advance(); // consume (*
-            bool terminated = false;
+        if (ch == '(' && at(pos + 1) == '*') {
+            size_t start = pos;
+            pos += 2; // consume (*
             while (true) {
-                char n = advance();
-                if (!n) {
-                    std::ostringstream oss;
-                    oss << "Unterminated (* ... *) comment at line " << start_line << ", col " << start_col; 
-                    errors.push_back(oss.str());
-                    break;  // Exit loop and continue lexing
+                size_t j = find_either(p, pos, n, '*', '\0');
+                if (j >= n || p[j] == '\0') {
+                    pos = j < n ? j + 1 : n; // past the NUL, if any
+                    errs.push_back(LexDiagnostic{LexErrorCode::UNTERMINATED_PAREN_COMMENT, static_cast<uint32_t>(start),
+                                                 static_cast<uint32_t>(pos - start)});
+                    break;  // continue lexing
                 }
-                if (n == '*' && peek() == ')') { 
-                    advance(); 
-                    terminated = true;
+                pos = j + 1;
+                if (at(pos) == ')') { 
+                    pos++; 
                     break; 
                 }
             }
@@ -75,138 +60,365 @@ void Lexer::skip_ws_comment(std::vector<std::string>& errors) {
     }
 }
 
+bool Lexer::scan_token(size_t& pos, Token& out, std::vector<LexDiagnostic>& errs, size_t& hint) const {
+    size_t start_i = pos;
+
+    // walk DFA (maximal munch)
+    ScanMatch m = generated ? generated_scan(src, start_i) : dfa->scan(src, start_i);
+
+    if (m.state < 0) {
+        pos = m.stop;
+        char bad = at(pos);
+        // Skip the bad character and continue
+        if (bad) pos++;
+        errs.push_back(LexDiagnostic{bad ? LexErrorCode::UNEXPECTED_CHARACTER : LexErrorCode::UNEXPECTED_END,
+                                     static_cast<uint32_t>(start_i), static_cast<uint32_t>(pos - start_i)});
+        return false;
+    }
+
+    // jump straight to the end of the longest accepted lexeme
+    pos = m.end;
+    std::string_view lexeme = src.substr(start_i, pos - start_i);
+
+    TokenKind kind = state_kinds[m.state];
+    if (kind == TokenKind::UNKNOWN) kind = lexeme_kind(lexeme);
+    if (kind == TokenKind::IDENTIFIER) kind = reserved_word_kind(lexeme);
+
+    SourcePos sp = lines.position_from(start_i, &hint);
+    out = Token{kind, static_cast<uint32_t>(start_i), lexeme, sp.line, sp.column};
+    if (kind == TokenKind::UNKNOWN) out.atom = state_atoms[m.state];
+    return true;
+}
+
+void Lexer::format_error(std::string& out, const LexDiagnostic& d) const {
+    switch (d.code) {
+    case LexErrorCode::UNEXPECTED_CHARACTER:
+        out += "Unexpected character '";
+        out += src[d.offset + d.length - 1];
+        out += "'";
+        break;
+    case LexErrorCode::UNEXPECTED_END:
+        out += "Unexpected character '?'";
+        break;
+    case LexErrorCode::UNTERMINATED_BRACE_COMMENT:
+        out += "Unterminated { ... } comment";
+        break;
+    case LexErrorCode::UNTERMINATED_PAREN_COMMENT:
+        out += "Unterminated (* ... *) comment";
+        break;
+    }
+    SourcePos sp = lines.position(d.offset);
+    out += " at line " + std::to_string(sp.line) + ", col " + std::to_string(sp.column);
+}
+
+// only the first error_limit errors are formatted, however many were found
+void Lexer::throw_errors(std::vector<LexDiagnostic> errs) const {
+    bool stopped = at_error_limit(errs);
+    if (stopped) errs.resize(error_limit);
+    std::string msg = "Lexical errors found (" + std::to_string(errs.size()) + "):\n";
+    for (size_t idx = 0; idx < errs.size(); ++idx) {
+        msg += "  [" + std::to_string(idx + 1) + "] ";
+        format_error(msg, errs[idx]);
+        msg += "\n";
+    }
+    if (stopped) msg += "  (stopped at the error limit)\n";
+    throw LexerError(msg, std::move(errs), stopped);
+}
+
+Token Lexer::next_token() {
+    if (!started) {
+        lines = LineIndex(src);
+        started = true;
+    }
+
+    while (true) {
+        skip_ws_comment(i, errors);
+        if (at_error_limit(errors)) {
+            i = src.size(); // give up on the rest
+            break;
+        }
+        if (!at(i)) break;
+
+        Token t;
+        if (scan_token(i, t, errors, line_hint)) {
+            if (t.kind == TokenKind::IDENTIFIER) t.atom = intern(t.value);
+            ++produced;
+            return t;
+        }
+    }
+    
+    // Display all collected errors at the end (once)
+    if (!errors.empty() && !errors_reported) {
+        errors_reported = true;
+        throw_errors(std::move(errors));
+    }
+    
+    return Token{}; // end of input
+}
+
 std::vector<Token> Lexer::tokenize() {
     std::vector<Token> tokens;
-    std::vector<std::string> errors;
+    for (Token t = next_token(); t.kind != TokenKind::NONE; t = next_token()) {
+        tokens.push_back(t);
+    }
+    return tokens;
+}
 
+TokenBuffer Lexer::tokenize_buffer() {
+    if (!started) {
+        lines = LineIndex(src);
+        started = true;
+    }
+    TokenBuffer buf(src, lines);
+    for (Token t = next_token(); t.kind != TokenKind::NONE; t = next_token()) {
+        buf.push(t);
+    }
+    return buf;
+}
+
+void Lexer::finish() {
+    while (next_token().kind != TokenKind::NONE) {
+    }
+}
+
+void Lexer::lex_span(size_t from, size_t limit, Span& out, const Span* sync) const {
+    size_t pos = from;
+    size_t hint = static_cast<size_t>(lines.position(from).line) - 1;
     while (true) {
-        skip_ws_comment(errors);
-        char ch = peek();
-        if (!ch) break;
-
-        int start_line = line, start_col = col;
-        std::string state = dfa.start();
-        std::string lexeme;
-        std::string last_final_state;
-        std::string last_final_lexeme;
-
-        size_t save_i = i; int save_line = line, save_col = col;
-
-        auto trans = [&](const std::string& curr_state, char c) -> std::string {
-            // 1) exact char
-            {
-                std::string s(1, c);
-                auto nxt = dfa.next_state(curr_state, s);
-                if (!nxt.empty()) return nxt;
-            }
-            // 2) char classes
-            for (const auto& cls : classify_char(c)) {
-                auto nxt = dfa.next_state(curr_state, cls);
-                if (!nxt.empty()) return nxt;
-            }
-            // 3) alnum or underscore
-            if (std::isalnum(static_cast<unsigned char>(c)) || c == '_') {
-                auto nxt = dfa.next_state(curr_state, "letter_or_digit_or_underscore");
-                if (!nxt.empty()) return nxt;
-            }
-            // 4) wildcard any
-            {
-                auto nxt = dfa.next_state(curr_state, "any");
-                if (!nxt.empty()) return nxt;
-            }
-            // any_non_quote untuk di dalam string/char
-            if (c != '\'') {
-                auto nxt2 = dfa.next_state(curr_state, "any_non_quote");
-                if (!nxt2.empty()) return nxt2;
-            }
-            return std::string();
-        };
-
-        // walk DFA
-        while (true) {
-            char c = peek();
-            if (!c) break;
-            std::string nxt = trans(state, c);
-            if (nxt.empty()) break;
-            lexeme.push_back(advance());
-            state = nxt;
-            if (dfa.finals().count(state)) {
-                last_final_state = state;
-                last_final_lexeme = lexeme;
+        skip_ws_comment(pos, out.errors);
+        if (!at(pos)) {
+            out.resume = pos;
+            out.ended = true;
+            return;
+        }
+        if (sync) {
+            // same offset as a speculative token start: from here on the
+            // speculative result is exactly what sequential lexing gives
+            auto it = std::lower_bound(sync->points.begin(), sync->points.end(), pos,
+                                       [](const SyncPoint& p, size_t off) { return p.offset < off; });
+            if (it != sync->points.end() && it->offset == pos) {
+                out.synced = static_cast<size_t>(it - sync->points.begin());
+                out.resume = sync->resume;
+                out.ended = sync->ended;
+                return;
             }
         }
-
-        if (last_final_state.empty()) {
-            char bad = peek();
-            std::ostringstream oss;
-            oss << "Unexpected character '" << (bad ? bad : '?')
-                << "' at line " << start_line << ", col " << start_col;
-            errors.push_back(oss.str());
-            // Skip the bad character and continue
-            if(peek()) advance();
-            continue;
+        if (pos >= limit) {
+            out.resume = pos;
+            return;
         }
+        out.points.push_back(SyncPoint{pos, static_cast<uint32_t>(out.tokens.size()),
+                                       static_cast<uint32_t>(out.errors.size())});
+        Token t;
+        if (scan_token(pos, t, out.errors, hint)) out.tokens.push_back(t);
+    }
+}
 
-        // rollback then re-consume exact final lexeme
-        i = save_i; line = save_line; col = save_col; lexeme.clear();
-        for (size_t k = 0; k < last_final_lexeme.size(); ++k) lexeme.push_back(advance());
-
-        std::string tok_type = map_state_to_type(last_final_state, lexeme);
-        if (tok_type == "IDENTIFIER") {
-            std::string lw = lexeme;
-            for (char& c : lw) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
-            if (KEYWORDS.count(lw)) tok_type = "KEYWORD";
-            else if (LOGICAL_WORDS.count(lw)) tok_type = "LOGICAL_OPERATOR";
-            else if (ARITH_WORDS.count(lw)) tok_type = "ARITHMETIC_OPERATOR";
-        }
+std::vector<Token> Lexer::tokenize_parallel(unsigned threads) {
+    const size_t n = src.size();
+    if (threads <= 1 || i != 0 || n < threads * min_chunk) return tokenize();
+    if (!started) {
+        lines = LineIndex(src);
+        started = true;
+    }
 
-        tokens.push_back(Token{tok_type, lexeme, start_line, start_col});
+    // chunk bounds, each moved to just past a newline
+    std::vector<size_t> bounds{0};
+    for (unsigned k = 1; k < threads; ++k) {
+        size_t b = std::max(n * k / threads, bounds.back());
+        b = find_either(src.data(), b, n, '\n', '\n');
+        if (b < n) ++b;
+        if (b > bounds.back() && b < n) bounds.push_back(b);
     }
-    
-    // Display all collected errors at the end
-    if (!errors.empty()) {
-        std::ostringstream agg;
-        agg << "Lexical errors found (" << errors.size() << "):\n";
-        for (size_t idx = 0; idx < errors.size(); ++idx) {
-            agg << "  [" << (idx + 1) << "] " << errors[idx] << "\n";
+    bounds.push_back(n);
+    const size_t chunks = bounds.size() - 1;
+
+    // speculative pass: every chunk assumes it starts between tokens
+    std::vector<Span> spec(chunks);
+    std::vector<std::thread> workers;
+    for (size_t k = 1; k < chunks; ++k) {
+        workers.emplace_back([this, &spec, &bounds, k] { lex_span(bounds[k], bounds[k + 1], spec[k], nullptr); });
+    }
+    lex_span(bounds[0], bounds[1], spec[0], nullptr);
+    for (auto& w : workers) w.join();
+
+    // reconciliation: enter each chunk where the previous one really ended
+    // (past a comment, string or token crossing the split), relexing until
+    // the speculative token starts are met again
+    // chunk 0 started at the real start, so it is taken as is
+    std::vector<Token> tokens = std::move(spec[0].tokens);
+    errors = std::move(spec[0].errors);
+    size_t total = tokens.size();
+    for (size_t k = 1; k < chunks; ++k) total += spec[k].tokens.size();
+    tokens.reserve(total);
+    size_t entry = spec[0].resume;
+    bool ended = spec[0].ended;
+    for (size_t k = 1; k < chunks && !ended; ++k) {
+        const Span& sp = spec[k];
+        Span fix;
+        lex_span(entry, bounds[k + 1], fix, &sp);
+        tokens.insert(tokens.end(), fix.tokens.begin(), fix.tokens.end());
+        errors.insert(errors.end(), fix.errors.begin(), fix.errors.end());
+        if (fix.synced != Span::NOT_SYNCED) {
+            const SyncPoint& at_sync = sp.points[fix.synced];
+            tokens.insert(tokens.end(), sp.tokens.begin() + at_sync.tokens_before, sp.tokens.end());
+            errors.insert(errors.end(), sp.errors.begin() + at_sync.errors_before, sp.errors.end());
         }
-        throw LexerError(agg.str());
+        entry = fix.resume;
+        ended = fix.ended;
+    }
+
+    // interned here, on one thread, in source order
+    for (Token& t : tokens) {
+        if (t.kind == TokenKind::IDENTIFIER) t.atom = intern(t.value);
+    }
+
+    i = n;
+    produced += tokens.size();
+    if (!errors.empty() && !errors_reported) {
+        errors_reported = true;
+        throw_errors(std::move(errors));
     }
-    
     return tokens;
 }
 
-std::string Lexer::map_state_to_type(const std::string& state, const std::string& lex) const {
-    // numbers
-    if (state == "NUM_INT" || state == "NUM_REAL") return "NUMBER";
+TokenRange Lexer::relex(std::vector<Token>& tokens, const SourceEdit& edit) {
+    const size_t n = src.size();
+    const size_t edit_end = edit.offset + edit.inserted.size(); // in the new text
+    if (edit_end > n || src.substr(edit.offset, edit.inserted.size()) != edit.inserted) {
+        throw std::invalid_argument("relex: source does not contain the edit");
+    }
+    auto old_end = [&](size_t k) { return static_cast<size_t>(tokens[k].offset) + tokens[k].value.size(); };
+    // the old text was n - inserted + removed bytes: the removed bytes and
+    // every old token have to lie inside it
+    if (edit.removed > std::numeric_limits<size_t>::max() - n) {
+        throw std::invalid_argument("relex: edit removes more than the old text held");
+    }
+    const size_t old_n = n - edit.inserted.size() + edit.removed;
+    if (edit.offset + edit.removed > old_n || (!tokens.empty() && old_end(tokens.size() - 1) > old_n)) {
+        throw std::invalid_argument("relex: tokens do not match the text before the edit");
+    }
+    const size_t shift_up = edit.inserted.size(), shift_down = edit.removed; // old -> new: + up - down
+    if (!started) {
+        lines = LineIndex(src);
+        started = true;
+    }
 
+    // restart after the last token whose walk stopped short of the edit:
+    // everything lexed before that point never looked at the edited bytes
+    size_t r = static_cast<size_t>(std::lower_bound(tokens.begin(), tokens.end(), edit.offset,
+        [](const Token& t, size_t off) { return t.offset < off; }) - tokens.begin());
+    while (r > 0) {
+        size_t s = tokens[r - 1].offset;
+        ScanMatch m = generated ? generated_scan(src, s) : dfa->scan(src, s);
+        if (m.stop < edit.offset) break;
+        --r;
+    }
+
+    size_t pos = r > 0 ? old_end(r - 1) : 0;
+    size_t hint = static_cast<size_t>(lines.position(pos).line) - 1;
+    std::vector<Token> fresh;
+    std::vector<LexDiagnostic> errs;
+    size_t resync = tokens.size(); // old index where the unchanged tail starts
+    while (true) {
+        if (pos >= edit_end) {
+            // past the edit and between tokens: if the old stream was between
+            // tokens at the same (shifted) point, the rest is unchanged
+            size_t old_pos = pos + shift_down - shift_up;
+            auto it = std::partition_point(tokens.begin() + r, tokens.end(),
+                [&](const Token& t) { return t.offset + t.value.size() < old_pos; });
+            if (it != tokens.end() && it->offset + it->value.size() == old_pos) {
+                resync = static_cast<size_t>(it - tokens.begin()) + 1;
+                break;
+            }
+        }
+        skip_ws_comment(pos, errs);
+        if (!at(pos)) break;
+        Token t;
+        if (scan_token(pos, t, errs, hint)) {
+            if (t.kind == TokenKind::IDENTIFIER) t.atom = intern(t.value);
+            fresh.push_back(t);
+        }
+    }
+    if (!errs.empty()) throw_errors(errs);
+
+    TokenRange range{r, resync - r, fresh.size()};
+    tokens.erase(tokens.begin() + r, tokens.begin() + resync);
+    tokens.insert(tokens.begin() + r, fresh.begin(), fresh.end());
+
+    // rebase the untouched tokens onto the new text
+    for (size_t k = 0; k < r; ++k) {
+        tokens[k].value = src.substr(tokens[k].offset, tokens[k].value.size());
+    }
+    hint = static_cast<size_t>(-1); // first lookup is a binary search
+    for (size_t k = r + fresh.size(); k < tokens.size(); ++k) {
+        Token& t = tokens[k];
+        size_t off = static_cast<size_t>(t.offset) + shift_up - shift_down;
+        SourcePos sp = lines.position_from(off, &hint);
+        t.offset = static_cast<uint32_t>(off);
+        t.value = src.substr(off, t.value.size());
+        t.line = sp.line;
+        t.column = sp.column;
+    }
+    return range;
+}
+
+// Kind given by the accepting state alone; UNKNOWN leaves it to the lexeme
+// (operators and punctuation share states in the DFA)
+static TokenKind state_kind(std::string_view state) {
+    if (state == "NUM_INT" || state == "NUM_REAL") return TokenKind::NUMBER;
+    if (state == "STR") return TokenKind::STRING_LITERAL;
+    if (state == "CHR") return TokenKind::CHAR_LITERAL;
+    // identifier / keyword / logical word dipisah di scan_token (reserved_word_kind)
+    if (state == "ID" || state == "ID_DASH") return TokenKind::IDENTIFIER;
+    if (state == "COMMENT_START") return TokenKind::COMMENT_START;
+    if (state == "COMMENT_END") return TokenKind::COMMENT_END;
+    return TokenKind::UNKNOWN;
+}
+
+TokenKind Lexer::lexeme_kind(std::string_view lex) {
     // range & assign
-    if (lex == ":=") return "ASSIGN_OPERATOR";
-    if (lex == "..") return "RANGE_OPERATOR";
-
-    // string/char
-    if (state == "STR") return "STRING_LITERAL";
-    if (state == "CHR") return "CHAR_LITERAL";
-
-    // punctuation (spesifik nama)
-    if (lex == ";") return "SEMICOLON";
-    if (lex == ",") return "COMMA";
-    if (lex == ":") return "COLON";
-    if (lex == ".") return "DOT";
-    if (lex == "(") return "LPARENTHESIS";
-    if (lex == ")") return "RPARENTHESIS";
-    if (lex == "[") return "LBRACKET";
-    if (lex == "]") return "RBRACKET";
-
-    // operators
-    if (lex == "+" || lex == "-" || lex == "*" || lex == "/")
-        return "ARITHMETIC_OPERATOR";
-    if (lex == "=" || lex == "<>" || lex == "<" || lex == "<=" || lex == ">" || lex == ">=")
-        return "RELATIONAL_OPERATOR";
-
-    // identifier / keyword / logical word handled di atas (post-processing)
-    if (state == "ID" || state == "ID_DASH") return "IDENTIFIER";
-
-    // fallback ke nama state (aman)
-    return state;
-}
\ No newline at end of file
+    if (lex == ":=") return TokenKind::ASSIGN;
+    if (lex == "..") return TokenKind::RANGE;
+
+    // punctuation & operators (spesifik nama)
+    if (lex.size() == 1) {
+        switch (lex[0]) {
+            case ';': return TokenKind::SEMICOLON;
+            case ',': return TokenKind::COMMA;
+            case ':': return TokenKind::COLON;
+            case '.': return TokenKind::DOT;
+            case '(': return TokenKind::LPARENTHESIS;
+            case ')': return TokenKind::RPARENTHESIS;
+            case '[': return TokenKind::LBRACKET;
+            case ']': return TokenKind::RBRACKET;
+            case '+': return TokenKind::PLUS;
+            case '-': return TokenKind::MINUS;
+            case '*': return TokenKind::STAR;
+            case '/': return TokenKind::SLASH;
+            case '=': return TokenKind::EQ;
+            case '<': return TokenKind::LT;
+            case '>': return TokenKind::GT;
+        }
+    }
+    if (lex == "<>") return TokenKind::NEQ;
+    if (lex == "<=") return TokenKind::LE;
+    if (lex == ">=") return TokenKind::GE;
+
+    // token class baru di DFA: dicetak pakai nama state-nya (lihat state_atoms)
+    return TokenKind::UNKNOWN;
+}
+
+// Done once here, on the constructing thread: scan_token then looks the
+// kind up by state id instead of comparing state names, and can tag UNKNOWN
+// tokens with their state name without touching the Interner.
+void Lexer::intern_state_names() {
+    state_kinds.assign(dfa->size(), TokenKind::UNKNOWN);
+    state_atoms.assign(dfa->size(), NO_ATOM);
+    for (size_t s = 0; s < dfa->size(); ++s) {
+        if (!dfa->is_final(static_cast<int>(s))) continue;
+        std::string_view name = dfa->name(static_cast<int>(s));
+        state_kinds[s] = state_kind(name);
+        state_atoms[s] = intern(name);
+    }
+}
@@ -0,0 +1,29 @@
+#include "lexer/line_index.hpp"
+#include "lexer/simd_scan.hpp"
+#include <algorithm>
+
+LineIndex::LineIndex(std::string_view src) {
+    starts.reserve(src.size() / 32 + 1);
+    starts.push_back(0);
+    collect_line_starts(src.data(), src.size(), starts);
+}
+
+SourcePos LineIndex::position(size_t offset) const {
+    if (starts.empty()) return SourcePos{1, static_cast<int>(offset) + 1};
+    auto it = std::upper_bound(starts.begin(), starts.end(), offset);
+    size_t line = static_cast<size_t>(it - starts.begin()); // 1-based
+    return SourcePos{static_cast<int>(line), static_cast<int>(offset - starts[line - 1]) + 1};
+}
+
+SourcePos LineIndex::position_from(size_t offset, size_t* hint) const {
+    if (starts.empty()) return SourcePos{1, static_cast<int>(offset) + 1};
+    size_t k = *hint;
+    if (k >= starts.size() || starts[k] > offset) {
+        SourcePos pos = position(offset);
+        *hint = static_cast<size_t>(pos.line) - 1;
+        return pos;
+    }
+    while (k + 1 < starts.size() && starts[k + 1] <= offset) ++k;
+    *hint = k;
+    return SourcePos{static_cast<int>(k) + 1, static_cast<int>(offset - starts[k]) + 1};
+}
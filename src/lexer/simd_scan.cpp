@@ -0,0 +1,87 @@
+#include "lexer/simd_scan.hpp"
+
+#if !defined(LEXER_NO_SIMD) && defined(__AVX2__)
+#include <immintrin.h>
+#define LEXER_AVX2 1
+#endif
+#if !defined(LEXER_NO_SIMD) && defined(__SSE2__)
+#include <emmintrin.h>
+#define LEXER_SSE2 1
+#endif
+
+static inline bool is_blank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+size_t skip_blanks(const char* p, size_t i, size_t n) {
+#ifdef LEXER_AVX2
+    const __m256i sp = _mm256_set1_epi8(' '), tab = _mm256_set1_epi8('\t');
+    const __m256i cr = _mm256_set1_epi8('\r'), lf = _mm256_set1_epi8('\n');
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        __m256i hit = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, sp), _mm256_cmpeq_epi8(v, tab)),
+                                      _mm256_or_si256(_mm256_cmpeq_epi8(v, cr), _mm256_cmpeq_epi8(v, lf)));
+        unsigned other = ~static_cast<unsigned>(_mm256_movemask_epi8(hit));
+        if (other) return i + __builtin_ctz(other);
+    }
+#endif
+#ifdef LEXER_SSE2
+    const __m128i sp16 = _mm_set1_epi8(' '), tab16 = _mm_set1_epi8('\t');
+    const __m128i cr16 = _mm_set1_epi8('\r'), lf16 = _mm_set1_epi8('\n');
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, sp16), _mm_cmpeq_epi8(v, tab16)),
+                                   _mm_or_si128(_mm_cmpeq_epi8(v, cr16), _mm_cmpeq_epi8(v, lf16)));
+        unsigned other = ~static_cast<unsigned>(_mm_movemask_epi8(hit)) & 0xFFFFu;
+        if (other) return i + __builtin_ctz(other);
+    }
+#endif
+    while (i < n && is_blank(p[i])) ++i;
+    return i;
+}
+
+size_t find_either(const char* p, size_t i, size_t n, char a, char b) {
+#ifdef LEXER_AVX2
+    const __m256i va = _mm256_set1_epi8(a), vb = _mm256_set1_epi8(b);
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        unsigned hit = static_cast<unsigned>(
+            _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, va), _mm256_cmpeq_epi8(v, vb))));
+        if (hit) return i + __builtin_ctz(hit);
+    }
+#endif
+#ifdef LEXER_SSE2
+    const __m128i va16 = _mm_set1_epi8(a), vb16 = _mm_set1_epi8(b);
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        unsigned hit = static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, va16), _mm_cmpeq_epi8(v, vb16))));
+        if (hit) return i + __builtin_ctz(hit);
+    }
+#endif
+    while (i < n && p[i] != a && p[i] != b) ++i;
+    return i;
+}
+
+void collect_line_starts(const char* p, size_t n, std::vector<uint32_t>& out) {
+    size_t i = 0;
+#ifdef LEXER_AVX2
+    const __m256i lf = _mm256_set1_epi8('\n');
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        unsigned hit = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, lf)));
+        for (; hit; hit &= hit - 1) out.push_back(static_cast<uint32_t>(i + __builtin_ctz(hit) + 1));
+    }
+#endif
+#ifdef LEXER_SSE2
+    const __m128i lf16 = _mm_set1_epi8('\n');
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        unsigned hit = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, lf16)));
+        for (; hit; hit &= hit - 1) out.push_back(static_cast<uint32_t>(i + __builtin_ctz(hit) + 1));
+    }
+#endif
+    for (; i < n; ++i) {
+        if (p[i] == '\n') out.push_back(static_cast<uint32_t>(i + 1));
+    }
+}
@@ -0,0 +1,105 @@
+#include "lexer/source_buffer.hpp"
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SOURCE_BUFFER_POSIX 1
+#endif
+
+SourceBuffer::~SourceBuffer() {
+    release();
+}
+
+SourceBuffer::SourceBuffer(SourceBuffer&& other) noexcept {
+    *this = std::move(other);
+}
+
+SourceBuffer& SourceBuffer::operator=(SourceBuffer&& other) noexcept {
+    if (this == &other) return *this;
+    release();
+    mapped = other.mapped;
+    size = other.size;
+    owned = std::move(other.owned);
+    data = mapped ? other.data : owned.data();
+    other.data = nullptr;
+    other.size = 0;
+    other.mapped = false;
+    return *this;
+}
+
+void SourceBuffer::release() {
+#ifdef SOURCE_BUFFER_POSIX
+    if (mapped && data) munmap(const_cast<char*>(data), size);
+#endif
+    data = nullptr;
+    size = 0;
+    mapped = false;
+    owned.clear();
+}
+
+#ifdef SOURCE_BUFFER_POSIX
+static bool read_fd(int fd, std::string& out) {
+    char buf[1 << 16];
+    while (true) {
+        ssize_t n = ::read(fd, buf, sizeof(buf));
+        if (n == 0) return true;
+        if (n < 0) return false;
+        out.append(buf, static_cast<size_t>(n));
+        if (out.size() > MAX_SOURCE_SIZE) return true; // too large: no point reading on
+    }
+}
+#endif
+
+static std::string too_large(const std::string& path) {
+    return "Source too large: " + path + " (the lexer handles at most " + std::to_string(MAX_SOURCE_SIZE) + " bytes)";
+}
+
+SourceBuffer SourceBuffer::open(const std::string& path) {
+    SourceBuffer sb;
+
+#ifdef SOURCE_BUFFER_POSIX
+    int fd = (path == "-") ? STDIN_FILENO : ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Cannot open source: " + path);
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        size_t len = static_cast<size_t>(st.st_size);
+        if (len > MAX_SOURCE_SIZE) {
+            if (fd != STDIN_FILENO) ::close(fd);
+            throw std::runtime_error(too_large(path));
+        }
+        void* p = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            madvise(p, len, MADV_SEQUENTIAL);
+            if (fd != STDIN_FILENO) ::close(fd);
+            sb.data = static_cast<const char*>(p);
+            sb.size = len;
+            sb.mapped = true;
+            return sb;
+        }
+    }
+
+    // pipe, stdin, empty file or mmap failure: read it all
+    bool ok = read_fd(fd, sb.owned);
+    if (fd != STDIN_FILENO) ::close(fd);
+    if (!ok) throw std::runtime_error("Cannot read source: " + path);
+#else
+    if (path == "-") {
+        sb.owned.assign(std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>());
+    } else {
+        std::ifstream f(path, std::ios::binary);
+        if (!f) throw std::runtime_error("Cannot open source: " + path);
+        sb.owned.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+    }
+#endif
+
+    if (sb.owned.size() > MAX_SOURCE_SIZE) throw std::runtime_error(too_large(path));
+    sb.data = sb.owned.data();
+    sb.size = sb.owned.size();
+    return sb;
+}
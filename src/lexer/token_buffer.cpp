@@ -0,0 +1,31 @@
+#include "lexer/token_buffer.hpp"
+
+void TokenBuffer::push(TokenKind kind, uint32_t offset, uint32_t length, Atom atom) {
+    if (kind == TokenKind::IDENTIFIER && atom == NO_ATOM) atom = intern(src.substr(offset, length));
+    kinds.push_back(kind);
+    offsets.push_back(offset);
+    lengths.push_back(length);
+    atoms.push_back(atom);
+}
+
+void TokenBuffer::append(const std::vector<Token>& tokens) {
+    reserve(size() + tokens.size());
+    for (const Token& t : tokens) push(t);
+}
+
+void TokenBuffer::reserve(size_t n) {
+    kinds.reserve(n);
+    offsets.reserve(n);
+    lengths.reserve(n);
+    atoms.reserve(n);
+}
+
+Token TokenBuffer::token(size_t k) const {
+    SourcePos sp = lines->position(offsets[k]);
+    return Token{kinds[k], offsets[k], text(k), sp.line, sp.column, atoms[k]};
+}
+
+Token TokenBuffer::token(size_t k, size_t* line_hint) const {
+    SourcePos sp = lines->position_from(offsets[k], line_hint);
+    return Token{kinds[k], offsets[k], text(k), sp.line, sp.column, atoms[k]};
+}
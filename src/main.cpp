@@ -1,6 +1,7 @@
 #include "utils.hpp"
 #include "lexer/lexer.hpp"
 #include "lexer/dfa_loader.hpp"
+#include "lexer/source_buffer.hpp"
 #include "parser/parser.hpp"
 #include "semantic/scope_type_checker.hpp"
 #include "ast/ast_builder.hpp"
@@ -8,94 +9,217 @@
 #include "ast/ast_printer_decorated.hpp"
 #include <iostream>
 #include <fstream>
+#include <algorithm>
 #include <filesystem>
+#include <thread>
+#include <charconv>
+#include <cstring>
+#include <limits>
 
+static bool has_suffix(const std::string& s, const std::string& suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// non-negative decimal count; anything else (sign, junk, overflow) is rejected
+static bool parse_count(const char* s, size_t& out) {
+    const char* end = s + std::strlen(s);
+    auto res = std::from_chars(s, end, out);
+    return *s != '\0' && res.ec == std::errc() && res.ptr == end;
+}
+
+// .dfa is mapped as-is (written already minimized by --convert-dfa);
+// .txt/.json are parsed, compiled and minimized, with a warning per
+// unreachable or dead state
+static CompiledDFA load_dfa_file(const std::string& path) {
+    if (has_suffix(path, ".dfa")) return load_dfa_bin(path);
+
+    CompiledDFA raw;
+    if (has_suffix(path, ".txt")) raw = load_dfa_txt(path).compile();
+    else if (has_suffix(path, ".json")) raw = load_dfa_json(path).compile();
+    else throw std::runtime_error("DFA must be .txt, .json or .dfa");
+
+    DFAReport report;
+    CompiledDFA dfa = minimize_dfa(raw, &report);
+    for (const auto& s : report.unreachable) std::cerr << "DFA warning: state " << s << " is unreachable\n";
+    for (const auto& s : report.dead) std::cerr << "DFA warning: state " << s << " can never accept\n";
+    return dfa;
+}
+
+// all tokens up front, kept column-wise; with jobs > 1 they are lexed in
+// parallel and the Token vector is dropped once copied into the buffer
+static TokenBuffer lex_buffered(Lexer& lex, std::string_view src, unsigned jobs) {
+    if (jobs <= 1) return lex.tokenize_buffer();
+    std::vector<Token> tokens = lex.tokenize_parallel(jobs);
+    TokenBuffer buf(src, lex.line_index());
+    buf.append(tokens);
+    return buf;
+}
 
 int main(int argc, char** argv) {
+    if (argc == 4 && std::string(argv[1]) == "--convert-dfa") {
+        try {
+            save_dfa_bin(load_dfa_file(Utils::resolve_from_here(argv[2])), argv[3]);
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to convert DFA: " << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
     if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << " <source.pas> [--dfa path/to/dfa.json|dfa.txt] [--tokens-only] [--ast]\n";
+        std::cerr << "Usage: " << argv[0] << " <source.pas|-> [--dfa path/to/dfa.json|dfa.txt|dfa.dfa] [--tokens-only] [--ast]\n";
+        std::cerr << "       " << argv[0] << " --convert-dfa <dfa.json|dfa.txt> <out.dfa>\n";
         std::cerr << "\nOptions:\n";
-        std::cerr << "  --dfa <path>      Specify DFA file (default: dfa/dfa.json)\n";
+        std::cerr << "  -                 Read the source from stdin instead of a file\n";
+        std::cerr << "  --dfa <path>      Lex with a DFA file loaded at runtime (default: built-in dfa/dfa.json)\n";
+        std::cerr << "  --convert-dfa     Precompile a DFA into the binary .dfa format\n";
+        std::cerr << "  --jobs <n>        Lex large sources on n threads (0: one per core)\n";
+        std::cerr << "  --max-errors <n>  Stop lexing after n lexical errors (0: no limit)\n";
+        std::cerr << "  --fail-fast       Stop at the first lexical error\n";
+        std::cerr << "  --compact-expr    Parse expressions into compact binary/unary nodes\n";
         std::cerr << "  --tokens-only     Only output tokens, skip parsing\n";
         std::cerr << "  --ast             Build and print Abstract Syntax Tree\n";
+        std::cerr << "  --direct-ast      Parse straight into the AST and print it (no parse tree,\n";
+        std::cerr << "                    no semantic analysis)\n";
         return 1;
     }
 
     std::string source = argv[1];
-    std::string dfa_path = "dfa/dfa.json";
+    std::string dfa_path;  // empty: built-in scanner generated from dfa/dfa.json
     bool tokens_only = false;
     bool build_ast = false;
     bool decorated = false; 
+    bool direct_ast = false;
+    unsigned jobs = 1;
+    LexerOptions lex_options;
+    ParserOptions parser_options;
 
     for (int i = 2; i < argc; i++) {
         std::string a = argv[i];
         if (a == "--dfa" && i + 1 < argc) {
             dfa_path = argv[++i];
+        } else if (a == "--jobs" && i + 1 < argc) {
+            size_t n = 0;
+            if (!parse_count(argv[++i], n) || n > std::numeric_limits<unsigned>::max()) {
+                std::cerr << "Invalid --jobs value: " << argv[i] << " (expected a thread count, 0 for one per core)\n";
+                return 1;
+            }
+            jobs = static_cast<unsigned>(n);
+            if (jobs == 0) jobs = std::max(1u, std::thread::hardware_concurrency());
+        } else if (a == "--max-errors" && i + 1 < argc) {
+            if (!parse_count(argv[++i], lex_options.max_errors)) {
+                std::cerr << "Invalid --max-errors value: " << argv[i] << " (expected a non-negative error count)\n";
+                return 1;
+            }
+        } else if (a == "--fail-fast") {
+            lex_options.fail_fast = true;
+        } else if (a == "--compact-expr") {
+            parser_options.compact_expressions = true;
         } else if (a == "--tokens-only") {
             tokens_only = true;
         } else if (a == "--ast") {
             build_ast = true; 
+        } else if (a == "--direct-ast") {
+            direct_ast = true;
         } else if (a == "--decorated") {
             decorated = true;
             build_ast = true;
         }
     }
 
-    source = Utils::resolve_from_here(source);
-    dfa_path = Utils::resolve_from_here(dfa_path);
-
-    // Load DFA
-    DFA dfa;
-    try {
-        if (dfa_path.size() >= 4 && dfa_path.substr(dfa_path.size() - 4) == ".txt")
-            dfa = load_dfa_txt(dfa_path);
-        else if (dfa_path.size() >= 5 && dfa_path.substr(dfa_path.size() - 5) == ".json")
-            dfa = load_dfa_json(dfa_path);
-        else {
-            std::cerr << "DFA must be .txt or .json\n";
+    // Load DFA (only when --dfa is given)
+    CompiledDFA compiled;
+    if (!dfa_path.empty()) {
+        dfa_path = Utils::resolve_from_here(dfa_path);
+        try {
+            compiled = load_dfa_file(dfa_path);
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to load DFA: " << e.what() << "\n";
             return 1;
         }
-    } catch (const std::exception& e) {
-        std::cerr << "Failed to load DFA: " << e.what() << "\n";
-        return 1;
     }
 
-    // Read source file
-    std::ifstream sf(source);
-    if (!sf) {
-        std::cerr << "Cannot open source: " << source << "\n";
+    // Read source file ("-" reads stdin); mapped when it is a regular file
+    // Path is tried as given first; resolve_from_here (../ fallback) only
+    // probes the filesystem when that fails.
+    SourceBuffer src_buf;
+    try {
+        try {
+            src_buf = SourceBuffer::open(source);
+        } catch (const std::exception&) {
+            std::string alt = source == "-" ? source : Utils::resolve_from_here(source);
+            if (alt == source) throw;
+            src_buf = SourceBuffer::open(alt);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
         return 1;
     }
+    std::string_view src = src_buf.view();
 
-    std::string src((std::istreambuf_iterator<char>(sf)), std::istreambuf_iterator<char>());
+    // Tokens and the parse tree view into src
+    Lexer lex = dfa_path.empty() ? Lexer(src) : Lexer(compiled, src);
+    lex.set_options(lex_options);
 
-    // Lexical Analysis
-    std::vector<Token> tokens;
-    try {
-        Lexer lex(dfa, src);
-        tokens = lex.tokenize();
-        
-        if (tokens_only) {
+    if (tokens_only) {
+        try {
+            TokenBuffer tokens = lex_buffered(lex, src, jobs);
             std::cout << "=== TOKENS ===\n";
-            for (const auto& t : tokens) {
-                std::cout << t.toString() << "\n";
+            for (size_t k = 0; k < tokens.size(); ++k) {
+                std::cout << token_type_name(tokens.kind(k), tokens.atom(k)) << "(" << tokens.text(k) << ")\n";
             }
             return 0;
+        } catch (const LexerError& e) {
+            std::cerr << "LEXER ERROR: " << e.what() << "\n";
+            return 1;
         }
-        
-        std::cout << "=== LEXICAL ANALYSIS SUCCESSFUL ===\n";
-        std::cout << "Total tokens: " << tokens.size() << "\n\n";
-        
+    }
+
+    // Lexical Analysis + parsing, interleaved: the parser pulls tokens from
+    // the lexer as it goes (with --jobs, all tokens are lexed up front).
+    // Lexical errors still win over syntax errors.
+    ParseTree parsetree;
+    std::unique_ptr<ASTProgramNode> direct;  // --direct-ast
+    bool parse_failed = false;
+    std::string parse_error;
+    TokenBuffer tokens;
+    try {
+        if (jobs > 1) tokens = lex_buffered(lex, src, jobs);
+        try {
+            Parser parser = jobs > 1 ? Parser(tokens) : Parser(lex);
+            parser.set_options(parser_options);
+            if (direct_ast) direct = parser.ast_program();
+            else parsetree = parser.pars_program();
+        } catch (const LexerError&) {
+            throw;
+        } catch (const std::exception& e) {
+            parse_failed = true;
+            parse_error = e.what();
+        }
+        lex.finish();
     } catch (const LexerError& e) {
         std::cerr << "LEXER ERROR: " << e.what() << "\n";
         return 1;
+    }
+
+    std::cout << "=== LEXICAL ANALYSIS SUCCESSFUL ===\n";
+    std::cout << "Total tokens: " << lex.token_count() << "\n\n";
+
+    if (parse_failed) {
+        std::cerr << "PARSER ERROR: " << parse_error << "\n";
         return 1;
     }
 
+    if (direct) {
+        std::cout << "=== PARSING SUCCESSFUL ===\n";
+        std::cout << "Program name: " << direct->program_name << "\n\n";
+        std::cout << "=== ABSTRACT SYNTAX TREE ===\n";
+        ASTPrinter printer;
+        direct->accept(&printer);
+        return 0;
+    }
+
     try {
-        Parser parser(tokens);
-        auto parsetree = parser.pars_program();
-        
         std::cout << "=== PARSING SUCCESSFUL ===\n";
         std::cout << "Program name: " << parsetree->pars_program_name << "\n\n";
         
@@ -1,80 +1,133 @@
 #include "parser/parser.hpp"
+#include "ast/ast_builder.hpp"
 #include <stdexcept>
 #include <sstream>
 
+static const Token NO_TOKEN; // cursor of an empty stream
+
+Parser::Parser(Lexer& lexer) 
+    : lexer(&lexer), current_pos(0) {
+    const Token* t = token_at(0);
+    current = t ? t : &NO_TOKEN;
+}
+
 Parser::Parser(const std::vector<Token>& tokens) 
-    : tokens(tokens), current_pos(0) {
-    if (!tokens.empty()) {
-        current_token = tokens[0];
-        while (current_token.type == "COMMENT" && current_pos < tokens.size() - 1) {
-            current_pos++;
-            current_token = tokens[current_pos];
+    : token_vec(&tokens), current_pos(0) {
+    const Token* t = token_at(0);
+    current = t ? t : &NO_TOKEN;
+}
+
+Parser::Parser(const TokenBuffer& buffer) 
+    : token_buf(&buffer), current_pos(0) {
+    const Token* t = token_at(0);
+    current = t ? t : &NO_TOKEN;
+}
+
+const Token* Parser::token_at(size_t pos) {
+    if (token_vec) return pos < token_vec->size() ? &(*token_vec)[pos] : nullptr;
+    while (pulled <= pos && !exhausted) {
+        Token t;
+        if (lexer) t = lexer->next_token();
+        else if (buf_pos < token_buf->size()) t = token_buf->token(buf_pos++, &line_hint);
+        if (t.kind == TokenKind::NONE) {
+            exhausted = true;
+            break;
         }
+        window[pulled % WINDOW] = t;
+        pulled++;
     }
+    if (pos >= pulled || pos + WINDOW <= pulled) return nullptr;
+    return &window[pos % WINDOW];
 }
 
 void Parser::advance() {
-    if (current_pos < tokens.size() - 1) {
+    if (const Token* next = token_at(current_pos + 1)) {
         current_pos++;
-        current_token = tokens[current_pos];
-        while (current_token.type == "COMMENT" && current_pos < tokens.size() - 1) {
-            current_pos++;
-            current_token = tokens[current_pos];
-        }
+        current = next;
     }
 }
 
-bool Parser::match(const std::string& type) {
-    if (check(type)) {
+bool Parser::match(TokenKind kind) {
+    if (check(kind)) {
         advance();
         return true;
     }
     return false;
 }
 
-bool Parser::check(const std::string& type) {
-    return current_token.type == type;
+bool Parser::check(TokenKind kind) {
+    return current->kind == kind;
 }
 
-void Parser::expect(const std::string& type, const std::string& message) {
-    if (!match(type)) {
+void Parser::expect(TokenKind kind, const std::string& message) {
+    if (!match(kind)) {
         std::stringstream ss;
-        ss << "Syntax error at line " << current_token.line 
-           << ", column " << current_token.column 
+        ss << "Syntax error at line " << current->line 
+           << ", column " << current->column 
            << ": " << message << "\n"
-           << "  Expected: " << type << "\n"
-           << "  Got: " << current_token.type << "(" << current_token.value << ")";
+           << "  Expected: " << token_kind_name(kind) << "\n"
+           << "  Got: " << current->type() << "(" << current->value << ")";
         
-        if (current_pos > 0 && current_pos < tokens.size()) {
+        if (current_pos > 0 && token_at(current_pos)) {
+            const Token* after1 = token_at(current_pos + 1);
+            const Token* after2 = token_at(current_pos + 2);
             ss << "\n  Context: ";
-            if (current_pos >= 2) ss << tokens[current_pos-2].value << " ";
-            if (current_pos >= 1) ss << tokens[current_pos-1].value << " ";
-            ss << ">>> " << current_token.value << " <<<";
-            if (current_pos + 1 < tokens.size()) ss << " " << tokens[current_pos+1].value;
-            if (current_pos + 2 < tokens.size()) ss << " " << tokens[current_pos+2].value;
+            if (current_pos >= 2) ss << token_at(current_pos-2)->value << " ";
+            if (current_pos >= 1) ss << token_at(current_pos-1)->value << " ";
+            ss << ">>> " << current->value << " <<<";
+            if (after1) ss << " " << after1->value;
+            if (after2) ss << " " << after2->value;
         }
         
         throw SyntaxError(ss.str());
     }
 }
 
-Token Parser::peek(int offset) {
-    size_t pos = current_pos + offset;
-    if (pos < tokens.size()) {
-        return tokens[pos];
+const Token& Parser::peek(int offset) {
+    if (const Token* t = token_at(current_pos + offset)) {
+        return *t;
     }
-    return current_token;
+    return *current;
 }
 
-Token Parser::previous() {
+const Token& Parser::previous() {
     if (current_pos > 0) {
-        return tokens[current_pos - 1];
+        return *token_at(current_pos - 1);
     }
-    return current_token;
+    return *current;
+}
+
+// "Error at line L, column C: message", the note lines, and what was found
+void Parser::error_at_current(const std::string& message, const std::string& note) {
+    std::stringstream ss;
+    ss << "Error at line " << current->line << ", column " << current->column 
+       << ": " << message << "\n"
+       << note
+       << "  Got: " << current->type() << "(" << current->value << ")";
+    throw SyntaxError(ss.str());
+}
+
+void Parser::unexpected_in_statement() {
+    std::stringstream ss;
+    ss << "Syntax error at line " << current->line 
+       << ", column " << current->column 
+       << ": Unexpected token in statement\n"
+       << "  Got: " << current->type() << "(" << current->value << ")\n"
+       << "  Expected one of: assignment, procedure call, if, while, for, or compound statement\n"
+       << "  Valid statement starters: identifier, jika, selama, untuk, mulai, writeln, write";
+    throw SyntaxError(ss.str());
 }
 
-std::unique_ptr<ProgramNode> Parser::pars_program() {
-    auto prog_node = std::make_unique<ProgramNode>();
+void Parser::unexpected_in_expression() {
+    std::stringstream ss;
+    ss << "Syntax error at line " << current->line 
+       << ", column " << current->column 
+       << ": unexpected token in expression " << current->type() << "(" << current->value << ")";
+    throw SyntaxError(ss.str());
+}
+
+ParseTree Parser::pars_program() {
+    auto prog_node = make<ProgramNode>();
     
     auto header = pars_program_header();
     if (auto* prog_header = dynamic_cast<ProgramHeaderNode*>(header.get())) {
@@ -86,227 +139,227 @@ std::unique_ptr<ProgramNode> Parser::pars_program() {
     
     prog_node->pars_compound_statement = pars_compound_statement();
     
-    if (!check("DOT")) {
+    if (!check(TokenKind::DOT)) {
         throw SyntaxError("Expected '.' at end of program");
     }
-    prog_node->dot_token = current_token;
+    prog_node->dot_token = *current;
     advance();
     
-    return prog_node;
+    return ParseTree(std::move(arena), prog_node.get());
 }
 
-std::unique_ptr<ParseTreeNode> Parser::pars_program_header() {
-    auto header_node = std::make_unique<ProgramHeaderNode>();
+NodePtr<ParseTreeNode> Parser::pars_program_header() {
+    auto header_node = make<ProgramHeaderNode>();
     
-    if (!check("KEYWORD") || current_token.value != "program") {
+    if (!check(TokenKind::KW_PROGRAM)) {
         std::stringstream ss;
-        ss << "Error at line " << current_token.line << ", column " << current_token.column 
+        ss << "Error at line " << current->line << ", column " << current->column 
            << ": Expected keyword 'program' at the beginning of the program\n"
-           << "  Got: " << current_token.type << "(" << current_token.value << ")";
+           << "  Got: " << current->type() << "(" << current->value << ")";
         throw SyntaxError(ss.str());
     }
-    header_node->program_keyword = current_token; 
+    header_node->program_keyword = *current; 
     advance();
     
-    if (check("IDENTIFIER")) {
-        header_node->program_name = current_token; 
+    if (check(TokenKind::IDENTIFIER)) {
+        header_node->program_name = *current; 
         advance();
     } else {
         std::stringstream ss;
-        ss << "Error at line " << current_token.line << ", column " << current_token.column 
+        ss << "Error at line " << current->line << ", column " << current->column 
            << ": Expected program name (identifier) after 'program' keyword\n"
-           << "  Got: " << current_token.type << "(" << current_token.value << ")";
+           << "  Got: " << current->type() << "(" << current->value << ")";
         throw SyntaxError(ss.str());
     }
     
-    if (!check("SEMICOLON")) {
+    if (!check(TokenKind::SEMICOLON)) {
         std::stringstream ss;
-        ss << "Error at line " << current_token.line << ", column " << current_token.column 
+        ss << "Error at line " << current->line << ", column " << current->column 
            << ": Expected ';' after program name\n"
            << "  Program name: " << header_node->program_name.value << "\n"
-           << "  Got: " << current_token.type << "(" << current_token.value << ")";
+           << "  Got: " << current->type() << "(" << current->value << ")";
         throw SyntaxError(ss.str());
     }
-    header_node->semicolon = current_token;  
+    header_node->semicolon = *current;  
     advance();
     
     return header_node;
 }
 
-std::unique_ptr<DeclarationPartNode> Parser::pars_declaration_part() {
-    auto decl_part_node = std::make_unique<DeclarationPartNode>();
+NodePtr<DeclarationPartNode> Parser::pars_declaration_part() {
+    auto decl_part_node = make<DeclarationPartNode>();
     
-    if (check("KEYWORD") && current_token.value == "konstanta") {
-        Token const_keyword = current_token;
+    if (check(TokenKind::KW_KONSTANTA)) {
+        Token const_keyword = *current;
         advance(); 
         
-        while (check("IDENTIFIER")) {
+        while (check(TokenKind::IDENTIFIER)) {
             auto const_decl = pars_const_declaration();
             const_decl->const_keyword = const_keyword; 
-            decl_part_node->pars_const_declaration_list.push_back(std::move(const_decl));
+            decl_part_node->pars_const_declaration_list.push_back(*arena, std::move(const_decl));
         }
     }
     
-    if (check("KEYWORD") && current_token.value == "tipe") {
-        Token type_keyword = current_token;
+    if (check(TokenKind::KW_TIPE)) {
+        Token type_keyword = *current;
         advance(); 
         
-        while (check("IDENTIFIER")) {
+        while (check(TokenKind::IDENTIFIER)) {
             auto type_decl = pars_type_declaration();
             type_decl->type_keyword = type_keyword;
-            decl_part_node->pars_type_declaration_list.push_back(std::move(type_decl));
+            decl_part_node->pars_type_declaration_list.push_back(*arena, std::move(type_decl));
         }
     }
     
-    if (check("KEYWORD") && current_token.value == "variabel") {
-        Token var_keyword = current_token;
+    if (check(TokenKind::KW_VARIABEL)) {
+        Token var_keyword = *current;
         advance(); 
         
-        while (check("IDENTIFIER")) {
+        while (check(TokenKind::IDENTIFIER)) {
             auto var_decl = pars_variable_declaration_part();
             var_decl->var_keyword = var_keyword;
-            decl_part_node->pars_variable_declaration_list.push_back(std::move(var_decl));
+            decl_part_node->pars_variable_declaration_list.push_back(*arena, std::move(var_decl));
         }
     }
     
-    while (check("KEYWORD") && (current_token.value == "prosedur" || current_token.value == "fungsi")) {
+    while (check(TokenKind::KW_PROSEDUR) || check(TokenKind::KW_FUNGSI)) {
         auto subprog_decl = pars_subprogram_declaration();
-        decl_part_node->pars_subprogram_declaration_list.push_back(std::move(subprog_decl));
+        decl_part_node->pars_subprogram_declaration_list.push_back(*arena, std::move(subprog_decl));
     }
     
     return decl_part_node;
 }
 
-std::unique_ptr<VariableDeclarationNode> Parser::pars_variable_declaration_part() {
-    auto var_decl_node = std::make_unique<VariableDeclarationNode>();
+NodePtr<VariableDeclarationNode> Parser::pars_variable_declaration_part() {
+    auto var_decl_node = make<VariableDeclarationNode>();
       
     var_decl_node->pars_identifier_list = pars_identifier_list();
     
-    if (!check("COLON")) {
+    if (!check(TokenKind::COLON)) {
         std::stringstream ss;
-        ss << "Error at line " << current_token.line << ", column " << current_token.column 
+        ss << "Error at line " << current->line << ", column " << current->column 
            << ": Expected ':' after variable identifier list\n"
            << "  Variables: ";
         for (const auto& id : var_decl_node->pars_identifier_list->pars_identifier_list) {
-            ss << id << " ";
+            ss << atom_name(id) << " ";
         }
-        ss << "\n  Got: " << current_token.type << "(" << current_token.value << ")";
+        ss << "\n  Got: " << current->type() << "(" << current->value << ")";
         throw SyntaxError(ss.str());
     }
-    var_decl_node->colon = current_token;
+    var_decl_node->colon = *current;
     advance();
     
     var_decl_node->pars_type = pars_type();
     
-    if (!check("SEMICOLON")) {
+    if (!check(TokenKind::SEMICOLON)) {
         std::stringstream ss;
-        ss << "Error at line " << current_token.line << ", column " << current_token.column 
+        ss << "Error at line " << current->line << ", column " << current->column 
            << ": Expected ';' after variable type declaration\n"
-           << "  Got: " << current_token.type << "(" << current_token.value << ")";
+           << "  Got: " << current->type() << "(" << current->value << ")";
         throw SyntaxError(ss.str());
     }
-    var_decl_node->semicolon = current_token;
+    var_decl_node->semicolon = *current;
     advance();
     
     return var_decl_node;
 }
 
-std::unique_ptr<ConstDeclarationNode> Parser::pars_const_declaration() {
-    auto const_decl_node = std::make_unique<ConstDeclarationNode>();
+NodePtr<ConstDeclarationNode> Parser::pars_const_declaration() {
+    auto const_decl_node = make<ConstDeclarationNode>();
     
-    if (!check("IDENTIFIER")) {
+    if (!check(TokenKind::IDENTIFIER)) {
         throw SyntaxError("Expected identifier after 'konstanta'");
     }
-    const_decl_node->identifier = current_token;
+    const_decl_node->identifier = *current;
     advance();
     
-    if (!check("RELATIONAL_OPERATOR") || current_token.value != "=") {
+    if (!check(TokenKind::EQ)) {
         throw SyntaxError("Expected '=' after constant identifier");
     }
-    const_decl_node->equal = current_token;
+    const_decl_node->equal = *current;
     advance();
     
-    if (check("NUMBER") || check("STRING_LITERAL") || check("CHAR_LITERAL") ||
-        (check("KEYWORD") && (current_token.value == "benar" || current_token.value == "salah" || current_token.value == "true" || current_token.value == "false"))) {
-        const_decl_node->value = current_token;
+    if (check(TokenKind::NUMBER) || check(TokenKind::STRING_LITERAL) || check(TokenKind::CHAR_LITERAL) ||
+        check(TokenKind::KW_TRUE) || check(TokenKind::KW_FALSE)) {
+        const_decl_node->value = *current;
         advance();
     } else {
         throw SyntaxError("Expected constant value (number, string, char, or boolean)");
     }
     
-    if (!check("SEMICOLON")) {
+    if (!check(TokenKind::SEMICOLON)) {
         throw SyntaxError("Expected ';' after constant declaration");
     }
-    const_decl_node->semicolon = current_token;
+    const_decl_node->semicolon = *current;
     advance();
     
     return const_decl_node;
 }
 
-std::unique_ptr<TypeDeclarationNode> Parser::pars_type_declaration() {
-    auto type_decl_node = std::make_unique<TypeDeclarationNode>();
+NodePtr<TypeDeclarationNode> Parser::pars_type_declaration() {
+    auto type_decl_node = make<TypeDeclarationNode>();
     
-    if (!check("IDENTIFIER")) {
+    if (!check(TokenKind::IDENTIFIER)) {
         throw SyntaxError("Expected identifier after 'tipe'");
     }
-    type_decl_node->identifier = current_token;
+    type_decl_node->identifier = *current;
     advance();
     
-    if (!check("RELATIONAL_OPERATOR") || current_token.value != "=") {
+    if (!check(TokenKind::EQ)) {
         throw SyntaxError("Expected '=' after type identifier");
     }
-    type_decl_node->equal = current_token;
+    type_decl_node->equal = *current;
     advance();
     
-    if (check("KEYWORD") && current_token.value == "larik") {
+    if (check(TokenKind::KW_LARIK)) {
         type_decl_node->pars_type_definition = pars_array_type();
     } 
-    else if (check("KEYWORD") && (current_token.value == "integer" || current_token.value == "real" || current_token.value == "boolean" || current_token.value == "char")) {
+    else if (check(TokenKind::KW_INTEGER) || check(TokenKind::KW_REAL) || check(TokenKind::KW_BOOLEAN) || check(TokenKind::KW_CHAR)) {
         type_decl_node->pars_type_definition = pars_type();
     }
-    else if (check("NUMBER") || check("CHAR_LITERAL") || check("IDENTIFIER")) {
+    else if (check(TokenKind::NUMBER) || check(TokenKind::CHAR_LITERAL) || check(TokenKind::IDENTIFIER)) {
          type_decl_node->pars_type_definition = pars_range();
     }
     else {
         throw SyntaxError("Expected type definition (array, simple type, or range)");
     }
     
-    if (!check("SEMICOLON")) {
+    if (!check(TokenKind::SEMICOLON)) {
         throw SyntaxError("Expected ';' after type declaration");
     }
-    type_decl_node->semicolon = current_token;
+    type_decl_node->semicolon = *current;
     advance();
     
     return type_decl_node;
 }
 
-std::unique_ptr<ParseTreeNode> Parser::pars_array_type() {
-    auto array_node = std::make_unique<ArrayTypeNode>();
+NodePtr<ParseTreeNode> Parser::pars_array_type() {
+    auto array_node = make<ArrayTypeNode>();
     
-    if (!check("KEYWORD") || current_token.value != "larik") {
+    if (!check(TokenKind::KW_LARIK)) {
         throw SyntaxError("Expected keyword 'larik' for array type");
     }
-    array_node->array_keyword = current_token;
+    array_node->array_keyword = *current;
     advance();
     
-    if (!check("LBRACKET")) {
+    if (!check(TokenKind::LBRACKET)) {
         throw SyntaxError("Expected '[' after 'larik'");
     }
-    array_node->lbracket = current_token;
+    array_node->lbracket = *current;
     advance();
     
     array_node->pars_range = pars_range();
     
-    if (!check("RBRACKET")) {
+    if (!check(TokenKind::RBRACKET)) {
         throw SyntaxError("Expected ']' after array range");
     }
-    array_node->rbracket = current_token;
+    array_node->rbracket = *current;
     advance();
 
-    if (!check("KEYWORD") || current_token.value != "dari") {
+    if (!check(TokenKind::KW_DARI)) {
         throw SyntaxError("Expected keyword 'dari' after array range");
     }
-    array_node->of_keyword = current_token;
+    array_node->of_keyword = *current;
     advance();
     
     array_node->pars_type = pars_type();
@@ -314,15 +367,15 @@ std::unique_ptr<ParseTreeNode> Parser::pars_array_type() {
     return array_node;
 }
 
-std::unique_ptr<RangeNode> Parser::pars_range() {
-    auto range_node = std::make_unique<RangeNode>();
+NodePtr<RangeNode> Parser::pars_range() {
+    auto range_node = make<RangeNode>();
     
     range_node->pars_start_expression = pars_simple_expression();
     
-    if (!check("RANGE_OPERATOR")) {
+    if (!check(TokenKind::RANGE)) {
         throw SyntaxError("Expected '..' in range");
     }
-    range_node->range_operator = current_token;
+    range_node->range_operator = *current;
     advance();
     
     range_node->pars_end_expression = pars_simple_expression();
@@ -330,12 +383,12 @@ std::unique_ptr<RangeNode> Parser::pars_range() {
     return range_node;
 }
 
-std::unique_ptr<SubprogramDeclarationNode> Parser::pars_subprogram_declaration() {
-    auto subprog_node = std::make_unique<SubprogramDeclarationNode>();
+NodePtr<SubprogramDeclarationNode> Parser::pars_subprogram_declaration() {
+    auto subprog_node = make<SubprogramDeclarationNode>();
     
-    if (check("KEYWORD") && current_token.value == "prosedur") {
+    if (check(TokenKind::KW_PROSEDUR)) {
         subprog_node->pars_declaration = pars_procedure_declaration();
-    } else if (check("KEYWORD") && current_token.value == "fungsi") {
+    } else if (check(TokenKind::KW_FUNGSI)) {
         subprog_node->pars_declaration = pars_function_declaration();
     } else {
         throw SyntaxError("Expected 'prosedur' or 'fungsi' keyword");
@@ -344,127 +397,127 @@ std::unique_ptr<SubprogramDeclarationNode> Parser::pars_subprogram_declaration()
     return subprog_node;
 }
 
-std::unique_ptr<ParseTreeNode> Parser::pars_procedure_declaration() {
-    auto proc_node = std::make_unique<ProcedureDeclarationNode>();
+NodePtr<ParseTreeNode> Parser::pars_procedure_declaration() {
+    auto proc_node = make<ProcedureDeclarationNode>();
     
-    if (!check("KEYWORD") || current_token.value != "prosedur") {
+    if (!check(TokenKind::KW_PROSEDUR)) {
         throw SyntaxError("Expected keyword 'prosedur'");
     }
-    proc_node->procedure_keyword = current_token;
+    proc_node->procedure_keyword = *current;
     advance();
     
-    if (!check("IDENTIFIER")) {
+    if (!check(TokenKind::IDENTIFIER)) {
         throw SyntaxError("Expected identifier after 'prosedur'");
     }
-    proc_node->identifier = current_token;
+    proc_node->identifier = *current;
     advance();
     
-    if (check("LPARENTHESIS")) {
+    if (check(TokenKind::LPARENTHESIS)) {
         proc_node->pars_formal_parameter_list = pars_formal_parameter_list();
     }
     
-    if (!check("SEMICOLON")) {
+    if (!check(TokenKind::SEMICOLON)) {
         throw SyntaxError("Expected ';' after procedure header");
     }
-    proc_node->semicolon1 = current_token;
+    proc_node->semicolon1 = *current;
     advance();
     
     proc_node->pars_block = pars_procedure_block();
     
-    if (!check("SEMICOLON")) {
+    if (!check(TokenKind::SEMICOLON)) {
         throw SyntaxError("Expected ';' after procedure block");
     }
-    proc_node->semicolon2 = current_token;
+    proc_node->semicolon2 = *current;
     advance();
     
     return proc_node;
 }
 
-std::unique_ptr<ParseTreeNode> Parser::pars_function_declaration() {
-    auto func_node = std::make_unique<FunctionDeclarationNode>();
+NodePtr<ParseTreeNode> Parser::pars_function_declaration() {
+    auto func_node = make<FunctionDeclarationNode>();
     
-    if (!check("KEYWORD") || current_token.value != "fungsi") {
+    if (!check(TokenKind::KW_FUNGSI)) {
         throw SyntaxError("Expected keyword 'fungsi'");
     }
-    func_node->function_keyword = current_token;
+    func_node->function_keyword = *current;
     advance();
     
-    if (!check("IDENTIFIER")) {
+    if (!check(TokenKind::IDENTIFIER)) {
         throw SyntaxError("Expected identifier after 'fungsi'");
     }
-    func_node->identifier = current_token;
+    func_node->identifier = *current;
     advance();
     
-    if (check("LPARENTHESIS")) {
+    if (check(TokenKind::LPARENTHESIS)) {
         func_node->pars_formal_parameter_list = pars_formal_parameter_list();
     }
     
-    if (!check("COLON")) {
+    if (!check(TokenKind::COLON)) {
         throw SyntaxError("Expected ':' after function header");
     }
-    func_node->colon = current_token;
+    func_node->colon = *current;
     advance();
     
     func_node->pars_return_type = pars_type();
     
-    if (!check("SEMICOLON")) {
+    if (!check(TokenKind::SEMICOLON)) {
         throw SyntaxError("Expected ';' after function header");
     }
-    func_node->semicolon1 = current_token;
+    func_node->semicolon1 = *current;
     advance();
     
     func_node->pars_block = pars_procedure_block();
     
-    if (!check("SEMICOLON")) {
+    if (!check(TokenKind::SEMICOLON)) {
         throw SyntaxError("Expected ';' after function block");
     }
-    func_node->semicolon2 = current_token;
+    func_node->semicolon2 = *current;
     advance();
     
     return func_node;
 }
 
-std::unique_ptr<FormalParameterListNode> Parser::pars_formal_parameter_list() {
-    auto param_list_node = std::make_unique<FormalParameterListNode>();
+NodePtr<FormalParameterListNode> Parser::pars_formal_parameter_list() {
+    auto param_list_node = make<FormalParameterListNode>();
     
-    if (!check("LPARENTHESIS")) {
+    if (!check(TokenKind::LPARENTHESIS)) {
         throw SyntaxError("Expected '(' for parameter list");
     }
-    param_list_node->lparen = current_token;
+    param_list_node->lparen = *current;
     advance();
     
-    if (check("RPARENTHESIS")) {
-        param_list_node->rparen = current_token;
+    if (check(TokenKind::RPARENTHESIS)) {
+        param_list_node->rparen = *current;
         advance();
         return param_list_node;
     }
     
-    param_list_node->pars_parameter_groups.push_back(pars_parameter_group());
+    param_list_node->pars_parameter_groups.push_back(*arena, pars_parameter_group());
     
-    while (check("SEMICOLON")) {
-        param_list_node->semicolon_tokens.push_back(current_token);
+    while (check(TokenKind::SEMICOLON)) {
+        param_list_node->semicolon_tokens.push_back(*arena, *current);
         advance();
-        param_list_node->pars_parameter_groups.push_back(pars_parameter_group());
+        param_list_node->pars_parameter_groups.push_back(*arena, pars_parameter_group());
     }
     
-    if (!check("RPARENTHESIS")) {
+    if (!check(TokenKind::RPARENTHESIS)) {
         throw SyntaxError("Expected ')' after parameter list");
     }
-    param_list_node->rparen = current_token;
+    param_list_node->rparen = *current;
     advance();
     
     return param_list_node;
 }
 
-std::unique_ptr<ParameterGroupNode> Parser::pars_parameter_group() {
-    auto param_group_node = std::make_unique<ParameterGroupNode>();
+NodePtr<ParameterGroupNode> Parser::pars_parameter_group() {
+    auto param_group_node = make<ParameterGroupNode>();
     
     param_group_node->pars_identifier_list = pars_identifier_list();
     
-    if (!check("COLON")) {
+    if (!check(TokenKind::COLON)) {
         throw SyntaxError("Expected ':' after parameter identifiers");
     }
-    param_group_node->colon = current_token;
+    param_group_node->colon = *current;
     advance();
     
     param_group_node->pars_type = pars_type();
@@ -472,8 +525,15 @@ std::unique_ptr<ParameterGroupNode> Parser::pars_parameter_group() {
     return param_group_node;
 }
 
-std::unique_ptr<ParseTreeNode> Parser::pars_procedure_block() {
-    auto block_node = std::make_unique<ProgramNode>();
+NodePtr<ParseTreeNode> Parser::pars_procedure_block() {
+    auto block_node = make<ProgramNode>();
+    
+    // ast_program: the AST keeps no subprograms, the block is only checked
+    if (direct_ast) {
+        ast_declaration_part();
+        ast_compound_statement();
+        return block_node;
+    }
     
     block_node->pars_declaration_part = pars_declaration_part();
     
@@ -482,21 +542,21 @@ std::unique_ptr<ParseTreeNode> Parser::pars_procedure_block() {
     return block_node;
 }
 
-std::unique_ptr<IdentifierListNode> Parser::pars_identifier_list() {
-    auto id_list_node = std::make_unique<IdentifierListNode>();
+NodePtr<IdentifierListNode> Parser::pars_identifier_list() {
+    auto id_list_node = make<IdentifierListNode>();
     
-    if (check("IDENTIFIER")) {
-        id_list_node->pars_identifier_list.push_back(current_token.value);
-        id_list_node->identifier_tokens.push_back(current_token);  
+    if (check(TokenKind::IDENTIFIER)) {
+        id_list_node->pars_identifier_list.push_back(*arena, current->atom);
+        id_list_node->identifier_tokens.push_back(*arena, *current);  
         advance();
 
-        while (match("COMMA")) {
-            Token comma_token = tokens[current_pos - 1];  
-            id_list_node->comma_tokens.push_back(comma_token);
+        while (match(TokenKind::COMMA)) {
+            const Token& comma_token = previous();  
+            id_list_node->comma_tokens.push_back(*arena, comma_token);
             
-            if (check("IDENTIFIER")) {
-                id_list_node->pars_identifier_list.push_back(current_token.value);
-                id_list_node->identifier_tokens.push_back(current_token); 
+            if (check(TokenKind::IDENTIFIER)) {
+                id_list_node->pars_identifier_list.push_back(*arena, current->atom);
+                id_list_node->identifier_tokens.push_back(*arena, *current); 
                 advance();
             } else {
                 throw SyntaxError("Expected identifier after ','");
@@ -509,31 +569,25 @@ std::unique_ptr<IdentifierListNode> Parser::pars_identifier_list() {
     return id_list_node;
 }
 
-std::unique_ptr<ParseTreeNode> Parser::pars_type() {
+NodePtr<ParseTreeNode> Parser::pars_type() {
     
-    if (check("KEYWORD") && current_token.value == "larik") {
+    if (check(TokenKind::KW_LARIK)) {
         return pars_array_type();
     }
     
-    if (check("KEYWORD")) {
-        std::string type_value = current_token.value;
-        if (type_value == "integer" || 
-            type_value == "real" || 
-            type_value == "boolean" ||
-            type_value == "char") {
-            
-            auto type_node = std::make_unique<TypeNode>();
-            type_node->pars_type_name = type_value;
-            type_node->type_keyword = current_token; 
-            advance();
-            return type_node;
-        }
+    if (check(TokenKind::KW_INTEGER) || check(TokenKind::KW_REAL) ||
+        check(TokenKind::KW_BOOLEAN) || check(TokenKind::KW_CHAR)) {
+        auto type_node = make<TypeNode>();
+        type_node->pars_type_name = current->value;
+        type_node->type_keyword = *current; 
+        advance();
+        return type_node;
     }
 
-    if (check("IDENTIFIER")) {
-        auto type_node = std::make_unique<TypeNode>();
-        type_node->pars_type_name = current_token.value; 
-        type_node->type_keyword = current_token; 
+    if (check(TokenKind::IDENTIFIER)) {
+        auto type_node = make<TypeNode>();
+        type_node->pars_type_name = current->value; 
+        type_node->type_keyword = *current; 
         advance();
         return type_node;
     }
@@ -541,127 +595,105 @@ std::unique_ptr<ParseTreeNode> Parser::pars_type() {
     throw SyntaxError("Expected type (integer, real, boolean, char, array, or custom type identifier)");
 }
 
-std::unique_ptr<CompoundStatementNode> Parser::pars_compound_statement() {
-    auto compound_node = std::make_unique<CompoundStatementNode>();
+NodePtr<CompoundStatementNode> Parser::pars_compound_statement() {
+    auto compound_node = make<CompoundStatementNode>();
     
-    if (check("KEYWORD") && current_token.value == "mulai") {
-        compound_node->mulai_keyword = current_token; 
+    if (check(TokenKind::KW_MULAI)) {
+        compound_node->mulai_keyword = *current; 
         advance();
     } else {
-        std::stringstream ss;
-        ss << "Error at line " << current_token.line << ", column " << current_token.column 
-           << ": Expected keyword 'mulai' to begin compound statement\n"
-           << "  Note: All executable code must be inside 'mulai...selesai' block\n"
-           << "  Got: " << current_token.type << "(" << current_token.value << ")";
-        throw SyntaxError(ss.str());
+        error_at_current("Expected keyword 'mulai' to begin compound statement",
+                         "  Note: All executable code must be inside 'mulai...selesai' block\n");
     }
     
     auto stmt_list = pars_statement_list();
     compound_node->pars_statement_list = std::move(stmt_list->pars_statements);
     
-    if (check("KEYWORD") && current_token.value == "selesai") {
-        compound_node->selesai_keyword = current_token;  
+    if (check(TokenKind::KW_SELESAI)) {
+        compound_node->selesai_keyword = *current;  
         advance();
     } else {
-        std::stringstream ss;
-        ss << "Error at line " << current_token.line << ", column " << current_token.column 
-           << ": Expected keyword 'selesai' to end compound statement\n"
-           << "  Note: Every 'mulai' must have a matching 'selesai'\n"
-           << "  Got: " << current_token.type << "(" << current_token.value << ")";
-        throw SyntaxError(ss.str());
+        error_at_current("Expected keyword 'selesai' to end compound statement",
+                         "  Note: Every 'mulai' must have a matching 'selesai'\n");
     }
     
     return compound_node;
 }
 
-std::unique_ptr<StatementListNode> Parser::pars_statement_list() {
-    auto stmt_list_node = std::make_unique<StatementListNode>();
+NodePtr<StatementListNode> Parser::pars_statement_list() {
+    auto stmt_list_node = make<StatementListNode>();
     
-    if (check("KEYWORD") && current_token.value == "selesai") {
+    if (check(TokenKind::KW_SELESAI)) {
         return stmt_list_node;
     }
     
     auto stmt = pars_statement();
-    stmt_list_node->pars_statements.push_back(std::move(stmt));
+    stmt_list_node->pars_statements.push_back(*arena, std::move(stmt));
     
-    while (match("SEMICOLON")) {
-        Token semicolon_token = previous();
-        stmt_list_node->pars_statements.push_back(std::make_unique<TokenNode>(semicolon_token));
+    while (match(TokenKind::SEMICOLON)) {
+        const Token& semicolon_token = previous();
+        stmt_list_node->pars_statements.push_back(*arena, make<TokenNode>(semicolon_token));
         
-        if (check("KEYWORD") && current_token.value == "selesai") {
+        if (check(TokenKind::KW_SELESAI)) {
             break;
         }
         auto next_stmt = pars_statement();
-        stmt_list_node->pars_statements.push_back(std::move(next_stmt));
+        stmt_list_node->pars_statements.push_back(*arena, std::move(next_stmt));
     }
     
     return stmt_list_node;
 }
 
-std::unique_ptr<ParseTreeNode> Parser::pars_statement() {
-    if (check("SEMICOLON") || 
-        (check("KEYWORD") && current_token.value == "selesai")) {
-        return std::make_unique<ParseTreeNode>();
+NodePtr<ParseTreeNode> Parser::pars_statement() {
+    if (check(TokenKind::SEMICOLON) || 
+        (check(TokenKind::KW_SELESAI))) {
+        return make<ParseTreeNode>();
     }
     
-    if (check("KEYWORD") && current_token.value == "mulai") {
+    if (check(TokenKind::KW_MULAI)) {
         return pars_compound_statement();
     }
     
-    if (check("KEYWORD") && current_token.value == "jika") {
+    if (check(TokenKind::KW_JIKA)) {
         return pars_if_statement();
     }
     
-    if (check("KEYWORD") && current_token.value == "selama") {
+    if (check(TokenKind::KW_SELAMA)) {
         return pars_while_statement();
     }
     
-    if (check("KEYWORD") && current_token.value == "untuk") {
+    if (check(TokenKind::KW_UNTUK)) {
         return pars_for_statement();
     }
 
-    if (check("IDENTIFIER")) {
-        Token next = peek(1);
+    if (check(TokenKind::IDENTIFIER)) {
+        const Token& next = peek(1);
         
-        if (next.type == "ASSIGN_OPERATOR") {
+        if (next.kind == TokenKind::ASSIGN) {
             return pars_assignment_statement();
-        } else if (next.type == "LPARENTHESIS" || 
-                   next.type == "SEMICOLON" ||
-                   (next.type == "KEYWORD" && next.value == "selesai")) {
+        } else if (next.kind == TokenKind::LPARENTHESIS || 
+                   next.kind == TokenKind::SEMICOLON ||
+                   next.kind == TokenKind::KW_SELESAI) {
             return pars_procedure_call();
         }
     }
     
-    if (check("KEYWORD")) {
-        std::string keyword = current_token.value;
-        if (keyword == "writeln" || keyword == "write" || keyword == "readln" || keyword == "read") {
-            return pars_procedure_call();
-        }
-    }
-    
-    std::stringstream ss;
-    ss << "Syntax error at line " << current_token.line 
-       << ", column " << current_token.column 
-       << ": Unexpected token in statement\n"
-       << "  Got: " << current_token.type << "(" << current_token.value << ")\n"
-       << "  Expected one of: assignment, procedure call, if, while, for, or compound statement\n"
-       << "  Valid statement starters: identifier, jika, selama, untuk, mulai, writeln, write";
-    throw SyntaxError(ss.str());
+    unexpected_in_statement();
 }
 
-std::unique_ptr<ParseTreeNode> Parser::pars_assignment_statement() {
-    auto assign_node = std::make_unique<AssignmentStatementNode>();
+NodePtr<ParseTreeNode> Parser::pars_assignment_statement() {
+    auto assign_node = make<AssignmentStatementNode>();
     
-    if (!check("IDENTIFIER")) {
+    if (!check(TokenKind::IDENTIFIER)) {
         throw SyntaxError("Expected identifier in assignment statement");
     }
-    assign_node->identifier = current_token;
+    assign_node->identifier = *current;
     advance();
     
-    if (!check("ASSIGN_OPERATOR")) {
+    if (!check(TokenKind::ASSIGN)) {
         throw SyntaxError("Expected ':=' in assignment statement");
     }
-    assign_node->assign_operator = current_token;
+    assign_node->assign_operator = *current;
     advance();
     
     assign_node->pars_expression = pars_expression();
@@ -669,62 +701,62 @@ std::unique_ptr<ParseTreeNode> Parser::pars_assignment_statement() {
     return assign_node;
 }
 
-std::unique_ptr<ParseTreeNode> Parser::pars_procedure_call() {
-    auto proc_call_node = std::make_unique<ProcedureFunctionCallNode>();
+NodePtr<ParseTreeNode> Parser::pars_procedure_call() {
+    auto proc_call_node = make<ProcedureFunctionCallNode>();
     
-    if (check("IDENTIFIER") || check("KEYWORD")) {
-        proc_call_node->procedure_name = current_token;
+    if (check(TokenKind::IDENTIFIER) || is_keyword(current->kind)) {
+        proc_call_node->procedure_name = *current;
         advance();
     } else {
         throw SyntaxError("Expected procedure name");
     }
     
-    if (check("LPARENTHESIS")) {
-        proc_call_node->lparen = current_token;
+    if (check(TokenKind::LPARENTHESIS)) {
+        proc_call_node->lparen = *current;
         advance();
         
-        if (!check("RPARENTHESIS")) {
+        if (!check(TokenKind::RPARENTHESIS)) {
             proc_call_node->pars_parameter_list = pars_parameter_list();
         }
         
-        if (!check("RPARENTHESIS")) {
+        if (!check(TokenKind::RPARENTHESIS)) {
             throw SyntaxError("Expected ')' after parameter list");
         }
-        proc_call_node->rparen = current_token;
+        proc_call_node->rparen = *current;
         advance();
     }
     
     return proc_call_node;
 }
 
-std::unique_ptr<ParseTreeNode> Parser::pars_if_statement() {
-    auto if_node = std::make_unique<IfStatementNode>();
+NodePtr<ParseTreeNode> Parser::pars_if_statement() {
+    auto if_node = make<IfStatementNode>();
     
-    if (!check("KEYWORD") || current_token.value != "jika") {
+    if (!check(TokenKind::KW_JIKA)) {
         throw SyntaxError("Expected keyword 'jika'");
     }
-    if_node->if_keyword = current_token;
+    if_node->if_keyword = *current;
     advance();
     
     if_node->pars_condition = pars_expression();
     
-    if (!check("KEYWORD") || current_token.value != "maka") {
+    if (!check(TokenKind::KW_MAKA)) {
         throw SyntaxError("Expected keyword 'maka' after condition");
     }
-    if_node->then_keyword = current_token;
+    if_node->then_keyword = *current;
     advance();
     
     if_node->pars_then_statement = pars_statement();
     
-    if (check("SEMICOLON")) {
-        Token next = peek(1);
-        if (next.type == "KEYWORD" && next.value == "selain-itu") {
+    if (check(TokenKind::SEMICOLON)) {
+        const Token& next = peek(1);
+        if (next.kind == TokenKind::KW_SELAIN_ITU) {
             advance();
         }
     }
     
-    if (check("KEYWORD") && current_token.value == "selain-itu") {
-        if_node->else_keyword = current_token;
+    if (check(TokenKind::KW_SELAIN_ITU)) {
+        if_node->else_keyword = *current;
         advance();
         if_node->pars_else_statement = pars_statement();
     }
@@ -732,21 +764,21 @@ std::unique_ptr<ParseTreeNode> Parser::pars_if_statement() {
     return if_node;
 }
 
-std::unique_ptr<ParseTreeNode> Parser::pars_while_statement() {
-    auto while_node = std::make_unique<WhileStatementNode>();
+NodePtr<ParseTreeNode> Parser::pars_while_statement() {
+    auto while_node = make<WhileStatementNode>();
     
-    if (!check("KEYWORD") || current_token.value != "selama") {
+    if (!check(TokenKind::KW_SELAMA)) {
         throw SyntaxError("Expected keyword 'selama'");
     }
-    while_node->while_keyword = current_token;
+    while_node->while_keyword = *current;
     advance();
     
     while_node->pars_condition = pars_expression();
     
-    if (!check("KEYWORD") || current_token.value != "lakukan") {
+    if (!check(TokenKind::KW_LAKUKAN)) {
         throw SyntaxError("Expected keyword 'lakukan' after condition");
     }
-    while_node->do_keyword = current_token;
+    while_node->do_keyword = *current;
     advance();
     
     while_node->pars_body = pars_statement();
@@ -754,41 +786,41 @@ std::unique_ptr<ParseTreeNode> Parser::pars_while_statement() {
     return while_node;
 }
 
-std::unique_ptr<ParseTreeNode> Parser::pars_for_statement() {
-    auto for_node = std::make_unique<ForStatementNode>();
+NodePtr<ParseTreeNode> Parser::pars_for_statement() {
+    auto for_node = make<ForStatementNode>();
     
-    if (!check("KEYWORD") || current_token.value != "untuk") {
+    if (!check(TokenKind::KW_UNTUK)) {
         throw SyntaxError("Expected keyword 'untuk'");
     }
-    for_node->for_keyword = current_token;
+    for_node->for_keyword = *current;
     advance();
     
-    if (!check("IDENTIFIER")) {
+    if (!check(TokenKind::IDENTIFIER)) {
         throw SyntaxError("Expected identifier after 'untuk'");
     }
-    for_node->control_variable = current_token;
+    for_node->control_variable = *current;
     advance();
     
-    if (!check("ASSIGN_OPERATOR")) {
+    if (!check(TokenKind::ASSIGN)) {
         throw SyntaxError("Expected ':=' in for statement");
     }
-    for_node->assign_operator = current_token;
+    for_node->assign_operator = *current;
     advance();
     
     for_node->pars_initial_value = pars_expression();
     
-    if (!check("KEYWORD") || (current_token.value != "ke" && current_token.value != "turun-ke")) {
+    if (!check(TokenKind::KW_KE) && !check(TokenKind::KW_TURUN_KE)) {
         throw SyntaxError("Expected keyword 'ke' or 'turun-ke'");
     }
-    for_node->direction_keyword = current_token;
+    for_node->direction_keyword = *current;
     advance();
     
     for_node->pars_final_value = pars_expression();
     
-    if (!check("KEYWORD") || current_token.value != "lakukan") {
+    if (!check(TokenKind::KW_LAKUKAN)) {
         throw SyntaxError("Expected keyword 'lakukan' after final value");
     }
-    for_node->do_keyword = current_token;
+    for_node->do_keyword = *current;
     advance();
     
     for_node->pars_body = pars_statement();
@@ -796,160 +828,598 @@ std::unique_ptr<ParseTreeNode> Parser::pars_for_statement() {
     return for_node;
 }
 
-std::unique_ptr<ParseTreeNode> Parser::pars_expression() {
-    auto expr_node = std::make_unique<ExpressionNode>();
+// Binding levels of the compact expression parser, loosest first
+enum ExpressionLevel { LEVEL_NONE = 0, LEVEL_RELATIONAL, LEVEL_ADDITIVE, LEVEL_MULTIPLICATIVE };
+
+static int binary_level(TokenKind kind) {
+    if (is_relational_operator(kind)) return LEVEL_RELATIONAL;
+    switch (kind) {
+        case TokenKind::PLUS:
+        case TokenKind::MINUS:
+        case TokenKind::ATAU:
+            return LEVEL_ADDITIVE;
+        case TokenKind::STAR:
+        case TokenKind::SLASH:
+        case TokenKind::BAGI:
+        case TokenKind::MOD:
+        case TokenKind::DAN:
+            return LEVEL_MULTIPLICATIVE;
+        default:
+            return LEVEL_NONE;
+    }
+}
+
+NodePtr<ParseTreeNode> Parser::pars_expression() {
+    if (compact_expressions) {
+        return pars_compact_expression(LEVEL_RELATIONAL);
+    }
+    
+    auto expr_node = make<ExpressionNode>();
     
     expr_node->pars_left = pars_simple_expression();
     
-    if (check("RELATIONAL_OPERATOR") || check("LOGICAL_OPERATOR")) {
-        std::string op_val = current_token.value;
-        if (op_val == "=" || op_val == "<>" || op_val == "<" || 
-            op_val == "<=" || op_val == ">" || op_val == ">=") {
-            auto rel_op_node = std::make_unique<RelationalOperatorNode>();
-            rel_op_node->op_token = current_token;
-            expr_node->pars_relational_op = std::move(rel_op_node);
-            advance();
-            expr_node->pars_right = pars_simple_expression();
-        }
+    if (is_relational_operator(current->kind)) {
+        auto rel_op_node = make<RelationalOperatorNode>();
+        rel_op_node->op_token = *current;
+        expr_node->pars_relational_op = std::move(rel_op_node);
+        advance();
+        expr_node->pars_right = pars_simple_expression();
     }
     
     return expr_node;
 }
 
-std::unique_ptr<ParseTreeNode> Parser::pars_simple_expression() {
-    auto simple_expr_node = std::make_unique<SimpleExpressionNode>();
+NodePtr<ParseTreeNode> Parser::pars_simple_expression() {
+    auto simple_expr_node = make<SimpleExpressionNode>();
     
-    if (check("ARITHMETIC_OPERATOR") && (current_token.value == "+" || current_token.value == "-")) {
-        simple_expr_node->sign = current_token;
+    if (check(TokenKind::PLUS) || check(TokenKind::MINUS)) {
+        simple_expr_node->sign = *current;
         advance();
     }
     
-    simple_expr_node->pars_terms.push_back(pars_term());
+    simple_expr_node->pars_terms.push_back(*arena, pars_term());
     
-    while (check("ARITHMETIC_OPERATOR") || check("LOGICAL_OPERATOR")) {
-        std::string op_val = current_token.value;
-        if (op_val == "+" || op_val == "-" || op_val == "atau") {
-            auto add_op_node = std::make_unique<AdditiveOperatorNode>();
-            add_op_node->op_token = current_token;
-            simple_expr_node->pars_operators.push_back(std::move(add_op_node));
-            advance();
-            simple_expr_node->pars_terms.push_back(pars_term());
-        } else {
-            break;
-        }
+    while (check(TokenKind::PLUS) || check(TokenKind::MINUS) || check(TokenKind::ATAU)) {
+        auto add_op_node = make<AdditiveOperatorNode>();
+        add_op_node->op_token = *current;
+        simple_expr_node->pars_operators.push_back(*arena, std::move(add_op_node));
+        advance();
+        simple_expr_node->pars_terms.push_back(*arena, pars_term());
     }
     
     return simple_expr_node;
 }
 
-std::unique_ptr<ParseTreeNode> Parser::pars_term() {
-    auto term_node = std::make_unique<TermNode>();
+NodePtr<ParseTreeNode> Parser::pars_term() {
+    auto term_node = make<TermNode>();
     
-    term_node->pars_factors.push_back(pars_factor());
+    term_node->pars_factors.push_back(*arena, pars_factor());
     
-    while (check("ARITHMETIC_OPERATOR") || check("LOGICAL_OPERATOR") || check("KEYWORD")) {
-        std::string op_val = current_token.value;
-        if (op_val == "*" || op_val == "/" || op_val == "bagi" || 
-            op_val == "mod" || op_val == "dan") {
-            auto mult_op_node = std::make_unique<MultiplicativeOperatorNode>();
-            mult_op_node->op_token = current_token;
-            term_node->pars_operators.push_back(std::move(mult_op_node));
-            advance();
-            term_node->pars_factors.push_back(pars_factor());
-        } else {
-            break;
-        }
+    while (check(TokenKind::STAR) || check(TokenKind::SLASH) || check(TokenKind::BAGI) ||
+           check(TokenKind::MOD) || check(TokenKind::DAN)) {
+        auto mult_op_node = make<MultiplicativeOperatorNode>();
+        mult_op_node->op_token = *current;
+        term_node->pars_operators.push_back(*arena, std::move(mult_op_node));
+        advance();
+        term_node->pars_factors.push_back(*arena, pars_factor());
     }
     
     return term_node;
 }
 
-std::unique_ptr<ParseTreeNode> Parser::pars_factor() {
-    auto factor_node = std::make_unique<FactorNode>();
+NodePtr<ParseTreeNode> Parser::pars_factor() {
+    auto factor_node = make<FactorNode>();
     
-    if (check("LOGICAL_OPERATOR") && current_token.value == "tidak") {
-        factor_node->not_operator = current_token;
+    if (check(TokenKind::TIDAK)) {
+        factor_node->not_operator = *current;
         advance();
         factor_node->pars_expression = pars_factor();
         return factor_node;
     }
     
-    if (check("LPARENTHESIS")) {
-        Token lparen = current_token;
+    if (check(TokenKind::LPARENTHESIS)) {
         advance();
         factor_node->pars_expression = pars_expression();
-        if (!check("RPARENTHESIS")) {
+        if (!check(TokenKind::RPARENTHESIS)) {
             throw SyntaxError("Expected ')' after expression");
         }
         advance();
         return factor_node;
     }
     
-    if (check("NUMBER") || check("CHAR_LITERAL") || check("STRING_LITERAL")) {
-        factor_node->token = current_token;
+    if (check(TokenKind::NUMBER) || check(TokenKind::CHAR_LITERAL) || check(TokenKind::STRING_LITERAL)) {
+        factor_node->token = *current;
         advance();
         return factor_node;
     }
     
-    if (check("IDENTIFIER")) {
-        Token id_token = current_token;
+    if (check(TokenKind::IDENTIFIER)) {
+        if (peek(1).kind == TokenKind::LPARENTHESIS) {
+            factor_node->pars_procedure_function_call = pars_function_call();
+            return factor_node;
+        }
+        factor_node->token = *current;
         advance();
-        
-        if (check("LPARENTHESIS")) {
-            current_pos--;
-            current_token = id_token;
-            
-            auto proc_func_call_node = std::make_unique<ProcedureFunctionCallNode>();
-            proc_func_call_node->procedure_name = current_token;
-            advance();
-            
-            proc_func_call_node->lparen = current_token;
-            advance();
-            
-            if (!check("RPARENTHESIS")) {
-                proc_func_call_node->pars_parameter_list = pars_parameter_list();
+        return factor_node;
+    }
+    
+    if (check(TokenKind::KW_TRUE) || check(TokenKind::KW_FALSE)) {
+        factor_node->token = *current;
+        advance();
+        return factor_node;
+    }
+    
+    unexpected_in_expression();
+}
+
+// identifier ( [parameter-list] ) inside an expression
+NodePtr<ProcedureFunctionCallNode> Parser::pars_function_call() {
+    auto proc_func_call_node = make<ProcedureFunctionCallNode>();
+    proc_func_call_node->procedure_name = *current;
+    advance();
+    
+    proc_func_call_node->lparen = *current;
+    advance();
+    
+    if (!check(TokenKind::RPARENTHESIS)) {
+        proc_func_call_node->pars_parameter_list = pars_parameter_list();
+    }
+    
+    if (!check(TokenKind::RPARENTHESIS)) {
+        throw SyntaxError("Expected ')' after parameter list");
+    }
+    proc_func_call_node->rparen = *current;
+    advance();
+    
+    return proc_func_call_node;
+}
+
+// Precedence climbing over operators binding at min_level or tighter; same
+// language as pars_expression. Operators are left-associative, except that
+// relational ones do not chain (there is one per <expression>), and a sign
+// may only open a simple expression, covering its first term.
+NodePtr<ParseTreeNode> Parser::pars_compact_expression(int min_level) {
+    NodePtr<ParseTreeNode> left;
+    
+    if (min_level <= LEVEL_ADDITIVE && (check(TokenKind::PLUS) || check(TokenKind::MINUS))) {
+        auto sign_node = make<UnaryExpressionNode>();
+        sign_node->op_token = *current;
+        advance();
+        sign_node->pars_operand = pars_compact_expression(LEVEL_MULTIPLICATIVE);
+        left = sign_node;
+    } else {
+        left = pars_compact_operand();
+    }
+    
+    int level;
+    while ((level = binary_level(current->kind)) >= min_level) {
+        auto binary_node = make<BinaryExpressionNode>();
+        binary_node->pars_left = left;
+        binary_node->op_token = *current;
+        advance();
+        binary_node->pars_right = pars_compact_expression(level + 1);
+        left = binary_node;
+        if (level == LEVEL_RELATIONAL) break;
+    }
+    
+    return left;
+}
+
+// factor without the FactorNode: literals and identifiers become a TokenNode,
+// calls and parenthesized expressions are returned as they are
+NodePtr<ParseTreeNode> Parser::pars_compact_operand() {
+    if (check(TokenKind::TIDAK)) {
+        auto not_node = make<UnaryExpressionNode>();
+        not_node->op_token = *current;
+        advance();
+        not_node->pars_operand = pars_compact_operand();
+        return not_node;
+    }
+    
+    if (check(TokenKind::LPARENTHESIS)) {
+        advance();
+        auto inner = pars_compact_expression(LEVEL_RELATIONAL);
+        if (!check(TokenKind::RPARENTHESIS)) {
+            throw SyntaxError("Expected ')' after expression");
+        }
+        advance();
+        return inner;
+    }
+    
+    if (check(TokenKind::IDENTIFIER) && peek(1).kind == TokenKind::LPARENTHESIS) {
+        return pars_function_call();
+    }
+    
+    if (check(TokenKind::NUMBER) || check(TokenKind::CHAR_LITERAL) || check(TokenKind::STRING_LITERAL) ||
+        check(TokenKind::IDENTIFIER) || check(TokenKind::KW_TRUE) || check(TokenKind::KW_FALSE)) {
+        auto token_node = make<TokenNode>(*current);
+        advance();
+        return token_node;
+    }
+    
+    unexpected_in_expression();
+}
+
+NodePtr<ParseTreeNode> Parser::pars_parameter_list() {
+    auto param_list_node = make<ParameterListNode>();
+    
+    param_list_node->pars_parameters.push_back(*arena, pars_expression());
+    
+    while (check(TokenKind::COMMA)) {
+        param_list_node->comma_tokens.push_back(*arena, *current);
+        advance();
+        param_list_node->pars_parameters.push_back(*arena, pars_expression());
+    }
+    
+    return param_list_node;
+}
+// call targets may be keyword tokens, which carry no atom
+static Atom name_atom(const Token& token) {
+    return token.atom != NO_ATOM ? token.atom : intern(token.value);
+}
+
+std::unique_ptr<ASTProgramNode> Parser::ast_program() {
+    direct_ast = true;
+    auto ast_program = std::make_unique<ASTProgramNode>();
+    
+    auto header = pars_program_header();
+    if (auto* prog_header = dynamic_cast<ProgramHeaderNode*>(header.get())) {
+        ast_program->program_name = prog_header->program_name.value;
+    }
+    
+    ast_program->declarations = ast_declaration_part();
+    
+    ast_program->main_block = ast_compound_statement();
+    
+    if (!check(TokenKind::DOT)) {
+        throw SyntaxError("Expected '.' at end of program");
+    }
+    advance();
+    
+    return ast_program;
+}
+
+// same shape as pars_declaration_part; only variables reach the AST
+std::unique_ptr<ASTDeclarationListNode> Parser::ast_declaration_part() {
+    auto decl_list = std::make_unique<ASTDeclarationListNode>();
+    
+    if (check(TokenKind::KW_KONSTANTA)) {
+        advance();
+        while (check(TokenKind::IDENTIFIER)) {
+            pars_const_declaration();
+        }
+    }
+    
+    if (check(TokenKind::KW_TIPE)) {
+        advance();
+        while (check(TokenKind::IDENTIFIER)) {
+            pars_type_declaration();
+        }
+    }
+    
+    if (check(TokenKind::KW_VARIABEL)) {
+        advance();
+        while (check(TokenKind::IDENTIFIER)) {
+            auto var_decl_node = pars_variable_declaration_part();
+            auto var_decl = std::make_unique<ASTVarDeclNode>();
+            const auto& ids = var_decl_node->pars_identifier_list->pars_identifier_list;
+            var_decl->identifiers.assign(ids.begin(), ids.end());
+            if (auto* type_node = dynamic_cast<TypeNode*>(var_decl_node->pars_type.get())) {
+                var_decl->type_name = type_node->pars_type_name;
             }
-            
-            if (!check("RPARENTHESIS")) {
-                throw SyntaxError("Expected ')' after parameter list");
+            decl_list->declarations.push_back(std::move(var_decl));
+        }
+    }
+    
+    while (check(TokenKind::KW_PROSEDUR) || check(TokenKind::KW_FUNGSI)) {
+        pars_subprogram_declaration();
+    }
+    
+    return decl_list;
+}
+
+std::unique_ptr<ASTCompoundStmtNode> Parser::ast_compound_statement() {
+    auto compound = std::make_unique<ASTCompoundStmtNode>();
+    
+    if (check(TokenKind::KW_MULAI)) {
+        advance();
+    } else {
+        error_at_current("Expected keyword 'mulai' to begin compound statement",
+                         "  Note: All executable code must be inside 'mulai...selesai' block\n");
+    }
+    
+    // statement-list: empty statements leave nothing behind
+    if (!check(TokenKind::KW_SELESAI)) {
+        if (auto stmt = ast_statement()) {
+            compound->statements.push_back(std::move(stmt));
+        }
+        while (match(TokenKind::SEMICOLON)) {
+            if (check(TokenKind::KW_SELESAI)) {
+                break;
             }
-            proc_func_call_node->rparen = current_token;
-            advance();
-            
-            factor_node->pars_procedure_function_call = std::move(proc_func_call_node);
-            return factor_node;
-        } else {
-            factor_node->token = id_token;
-            return factor_node;
+            if (auto stmt = ast_statement()) {
+                compound->statements.push_back(std::move(stmt));
+            }
+        }
+    }
+    
+    if (check(TokenKind::KW_SELESAI)) {
+        advance();
+    } else {
+        error_at_current("Expected keyword 'selesai' to end compound statement",
+                         "  Note: Every 'mulai' must have a matching 'selesai'\n");
+    }
+    
+    return compound;
+}
+
+std::unique_ptr<ASTStatementNode> Parser::ast_statement() {
+    if (check(TokenKind::SEMICOLON) || check(TokenKind::KW_SELESAI)) {
+        return nullptr;
+    }
+    
+    if (check(TokenKind::KW_MULAI)) {
+        return ast_compound_statement();
+    }
+    
+    if (check(TokenKind::KW_JIKA)) {
+        return ast_if_statement();
+    }
+    
+    if (check(TokenKind::KW_SELAMA)) {
+        return ast_while_statement();
+    }
+    
+    if (check(TokenKind::KW_UNTUK)) {
+        return ast_for_statement();
+    }
+    
+    if (check(TokenKind::IDENTIFIER)) {
+        const Token& next = peek(1);
+        
+        if (next.kind == TokenKind::ASSIGN) {
+            return ast_assignment_statement();
+        } else if (next.kind == TokenKind::LPARENTHESIS || 
+                   next.kind == TokenKind::SEMICOLON ||
+                   next.kind == TokenKind::KW_SELESAI) {
+            return ast_procedure_call();
         }
     }
     
-    if (check("KEYWORD")) {
-        std::string kw = current_token.value;
-        if (kw == "benar" || kw == "salah" || kw == "true" || kw == "false") {
-            factor_node->token = current_token;
+    unexpected_in_statement();
+}
+
+std::unique_ptr<ASTStatementNode> Parser::ast_assignment_statement() {
+    auto assignment = std::make_unique<ASTAssignmentNode>();
+    
+    if (!check(TokenKind::IDENTIFIER)) {
+        throw SyntaxError("Expected identifier in assignment statement");
+    }
+    assignment->variable_name = current->atom;
+    advance();
+    
+    if (!check(TokenKind::ASSIGN)) {
+        throw SyntaxError("Expected ':=' in assignment statement");
+    }
+    advance();
+    
+    assignment->expression = ast_expression();
+    
+    return assignment;
+}
+
+std::unique_ptr<ASTStatementNode> Parser::ast_procedure_call() {
+    auto proc_call = std::make_unique<ASTProcedureCallNode>();
+    
+    if (check(TokenKind::IDENTIFIER) || is_keyword(current->kind)) {
+        proc_call->procedure_name = name_atom(*current);
+        advance();
+    } else {
+        throw SyntaxError("Expected procedure name");
+    }
+    
+    if (check(TokenKind::LPARENTHESIS)) {
+        advance();
+        
+        if (!check(TokenKind::RPARENTHESIS)) {
+            proc_call->arguments = ast_argument_list();
+        }
+        
+        if (!check(TokenKind::RPARENTHESIS)) {
+            throw SyntaxError("Expected ')' after parameter list");
+        }
+        advance();
+    }
+    
+    return proc_call;
+}
+
+std::unique_ptr<ASTStatementNode> Parser::ast_if_statement() {
+    auto if_node = std::make_unique<ASTIfNode>();
+    
+    if (!check(TokenKind::KW_JIKA)) {
+        throw SyntaxError("Expected keyword 'jika'");
+    }
+    advance();
+    
+    if_node->condition = ast_expression();
+    
+    if (!check(TokenKind::KW_MAKA)) {
+        throw SyntaxError("Expected keyword 'maka' after condition");
+    }
+    advance();
+    
+    if_node->then_stmt = ast_statement();
+    
+    if (check(TokenKind::SEMICOLON)) {
+        const Token& next = peek(1);
+        if (next.kind == TokenKind::KW_SELAIN_ITU) {
             advance();
-            return factor_node;
         }
     }
     
-    std::stringstream ss;
-    ss << "Syntax error at line " << current_token.line 
-       << ", column " << current_token.column 
-       << ": unexpected token in expression " << current_token.type << "(" << current_token.value << ")";
-    throw SyntaxError(ss.str());
+    if (check(TokenKind::KW_SELAIN_ITU)) {
+        advance();
+        if_node->else_stmt = ast_statement();
+    }
+    
+    return if_node;
+}
+
+std::unique_ptr<ASTStatementNode> Parser::ast_while_statement() {
+    auto while_node = std::make_unique<ASTWhileNode>();
+    
+    if (!check(TokenKind::KW_SELAMA)) {
+        throw SyntaxError("Expected keyword 'selama'");
+    }
+    advance();
+    
+    while_node->condition = ast_expression();
+    
+    if (!check(TokenKind::KW_LAKUKAN)) {
+        throw SyntaxError("Expected keyword 'lakukan' after condition");
+    }
+    advance();
+    
+    while_node->body = ast_statement();
+    
+    return while_node;
 }
 
-std::unique_ptr<ParseTreeNode> Parser::pars_parameter_list() {
-    auto param_list_node = std::make_unique<ParameterListNode>();
+std::unique_ptr<ASTStatementNode> Parser::ast_for_statement() {
+    auto for_node = std::make_unique<ASTForNode>();
+    
+    if (!check(TokenKind::KW_UNTUK)) {
+        throw SyntaxError("Expected keyword 'untuk'");
+    }
+    advance();
+    
+    if (!check(TokenKind::IDENTIFIER)) {
+        throw SyntaxError("Expected identifier after 'untuk'");
+    }
+    for_node->control_var = current->atom;
+    advance();
     
-    param_list_node->pars_parameters.push_back(pars_expression());
+    if (!check(TokenKind::ASSIGN)) {
+        throw SyntaxError("Expected ':=' in for statement");
+    }
+    advance();
+    
+    for_node->initial_value = ast_expression();
+    
+    if (!check(TokenKind::KW_KE) && !check(TokenKind::KW_TURUN_KE)) {
+        throw SyntaxError("Expected keyword 'ke' or 'turun-ke'");
+    }
+    for_node->is_downto = check(TokenKind::KW_TURUN_KE);
+    advance();
+    
+    for_node->final_value = ast_expression();
+    
+    if (!check(TokenKind::KW_LAKUKAN)) {
+        throw SyntaxError("Expected keyword 'lakukan' after final value");
+    }
+    advance();
+    
+    for_node->body = ast_statement();
+    
+    return for_node;
+}
+
+std::unique_ptr<ASTExpressionNode> Parser::ast_expression() {
+    return ast_binary_expression(LEVEL_RELATIONAL);
+}
+
+// pars_compact_expression, building AST nodes
+std::unique_ptr<ASTExpressionNode> Parser::ast_binary_expression(int min_level) {
+    std::unique_ptr<ASTExpressionNode> left;
     
-    while (check("COMMA")) {
-        param_list_node->comma_tokens.push_back(current_token);
+    if (min_level <= LEVEL_ADDITIVE && (check(TokenKind::PLUS) || check(TokenKind::MINUS))) {
+        auto sign_op = std::make_unique<ASTUnaryOpNode>();
+        sign_op->op = current->value;
         advance();
-        param_list_node->pars_parameters.push_back(pars_expression());
+        sign_op->operand = ast_binary_expression(LEVEL_MULTIPLICATIVE);
+        left = std::move(sign_op);
+    } else {
+        left = ast_operand();
     }
     
-    return param_list_node;
-}
\ No newline at end of file
+    int level;
+    while ((level = binary_level(current->kind)) >= min_level) {
+        auto binary_op = std::make_unique<ASTBinaryOpNode>();
+        binary_op->op = current->value;
+        advance();
+        binary_op->left = std::move(left);
+        binary_op->right = ast_binary_expression(level + 1);
+        left = std::move(binary_op);
+        if (level == LEVEL_RELATIONAL) break;
+    }
+    
+    return left;
+}
+
+std::unique_ptr<ASTExpressionNode> Parser::ast_operand() {
+    if (check(TokenKind::TIDAK)) {
+        auto not_op = std::make_unique<ASTUnaryOpNode>();
+        not_op->op = current->value;
+        advance();
+        not_op->operand = ast_operand();
+        return not_op;
+    }
+    
+    if (check(TokenKind::LPARENTHESIS)) {
+        advance();
+        auto inner = ast_expression();
+        if (!check(TokenKind::RPARENTHESIS)) {
+            throw SyntaxError("Expected ')' after expression");
+        }
+        advance();
+        return inner;
+    }
+    
+    if (check(TokenKind::IDENTIFIER) && peek(1).kind == TokenKind::LPARENTHESIS) {
+        auto func_call = std::make_unique<ASTFunctionCallNode>();
+        func_call->function_name = current->atom;
+        advance();
+        advance();
+        
+        if (!check(TokenKind::RPARENTHESIS)) {
+            func_call->arguments = ast_argument_list();
+        }
+        
+        if (!check(TokenKind::RPARENTHESIS)) {
+            throw SyntaxError("Expected ')' after parameter list");
+        }
+        advance();
+        return func_call;
+    }
+    
+    if (check(TokenKind::IDENTIFIER)) {
+        auto identifier = std::make_unique<ASTIdentifierNode>();
+        identifier->name = current->atom;
+        advance();
+        return identifier;
+    }
+    
+    if (check(TokenKind::NUMBER) || check(TokenKind::CHAR_LITERAL) || check(TokenKind::STRING_LITERAL) ||
+        check(TokenKind::KW_TRUE) || check(TokenKind::KW_FALSE)) {
+        auto literal = std::make_unique<ASTLiteralNode>();
+        literal->value = current->value;
+        literal->literal_type = ASTBuilder::getLiteralType(*current);
+        advance();
+        return literal;
+    }
+    
+    unexpected_in_expression();
+}
+
+std::vector<std::unique_ptr<ASTExpressionNode>> Parser::ast_argument_list() {
+    std::vector<std::unique_ptr<ASTExpressionNode>> arguments;
+    
+    arguments.push_back(ast_expression());
+    
+    while (match(TokenKind::COMMA)) {
+        arguments.push_back(ast_expression());
+    }
+    
+    return arguments;
+}
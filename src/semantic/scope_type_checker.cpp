@@ -23,7 +23,7 @@ void ScopeTypeChecker::visitProgram(ProgramNode* node) {
     
     // Insert program name to symbol table
     try {
-        symbolTable->insert(node->pars_program_name, ObjectKind::PROCEDURE, 
+        symbolTable->insert(std::string(node->pars_program_name), ObjectKind::PROCEDURE, 
                           BaseType::NOTYPE, 0, true, 0);
         std::cout << "[Semantic] Program '" << node->pars_program_name 
                   << "' registered" << std::endl;
@@ -106,12 +106,12 @@ void ScopeTypeChecker::visitVarDecl(VariableDeclarationNode* node) {
         const auto& identifiers = node->pars_identifier_list->pars_identifier_list;
         
         for (size_t i = 0; i < identifiers.size(); i++) {
-            std::cout << identifiers[i];
+            std::cout << atom_name(identifiers[i]);
             if (i < identifiers.size() - 1) std::cout << ", ";
             
             // Cek apakah sudah dideklarasikan di scope saat ini
             if (isDeclaredInCurrentScope(identifiers[i])) {
-                throw SemanticError("Variable '" + identifiers[i] + 
+                throw SemanticError("Variable '" + std::string(atom_name(identifiers[i])) + 
                                   "' already declared in current scope");
             }
             
@@ -146,25 +146,25 @@ void ScopeTypeChecker::visitConstDecl(ConstDeclarationNode* node) {
               << " = " << node->value.value << std::endl;
     
     // Cek apakah sudah dideklarasikan
-    if (isDeclaredInCurrentScope(node->identifier.value)) {
-        throw SemanticError("Constant '" + node->identifier.value + 
+    if (isDeclaredInCurrentScope(node->identifier.atom)) {
+        throw SemanticError("Constant '" + node->identifier.text() + 
                           "' already declared in current scope");
     }
     
     // Tentukan tipe dari nilai
-    BaseType constType = inferTypeFromValue(node->value.value);
+    BaseType constType = inferTypeFromValue(node->value.text());
     
     // Parse nilai konstanta
     int constValue = 0;
     try {
-        constValue = std::stoi(node->value.value);
+        constValue = std::stoi(node->value.text());
     } catch (...) {
         constValue = 0;  // Default untuk non-integer
     }
     
     // Insert ke symbol table
     try {
-        int constIdx = symbolTable->insert(node->identifier.value, ObjectKind::CONSTANT, 
+        int constIdx = symbolTable->insert(node->identifier.atom, ObjectKind::CONSTANT, 
                                           constType, 0, true, constValue);
         std::cout << "  - Constant '" << node->identifier.value << "' inserted at index " 
                   << constIdx << std::endl;
@@ -177,8 +177,8 @@ void ScopeTypeChecker::visitTypeDecl(TypeDeclarationNode* node) {
     std::cout << "[Semantic] Declaring type " << node->identifier.value << std::endl;
     
     // Cek apakah sudah dideklarasikan
-    if (isDeclaredInCurrentScope(node->identifier.value)) {
-        throw SemanticError("Type '" + node->identifier.value + 
+    if (isDeclaredInCurrentScope(node->identifier.atom)) {
+        throw SemanticError("Type '" + node->identifier.text() + 
                           "' already declared in current scope");
     }
     
@@ -191,19 +191,19 @@ void ScopeTypeChecker::visitTypeDecl(TypeDeclarationNode* node) {
         ref = processArrayType(arrayNode);
     } else if (auto* typeNode = dynamic_cast<TypeNode*>(node->pars_type_definition.get())) {
         // Alias tipe
-        typeCode = getBaseType(typeNode->pars_type_name);
+        typeCode = getBaseType(std::string(typeNode->pars_type_name));
         ref = 0;
     } else if (auto* rangeNode = dynamic_cast<RangeNode*>(node->pars_type_definition.get())) {
         // Range type (e.g., 1..100) is treated as integer type
         typeCode = BaseType::INTS;
         ref = 0;
     } else {
-        throw SemanticError("Unknown type definition for '" + node->identifier.value + "'");
+        throw SemanticError("Unknown type definition for '" + node->identifier.text() + "'");
     }
     
     // Insert ke symbol table
     try {
-        int typeIdx = symbolTable->insert(node->identifier.value, ObjectKind::TYPE_ID, 
+        int typeIdx = symbolTable->insert(node->identifier.atom, ObjectKind::TYPE_ID, 
                                          typeCode, ref, true, 0);
         std::cout << "  - Type '" << node->identifier.value << "' inserted at index " 
                   << typeIdx << std::endl;
@@ -216,8 +216,8 @@ void ScopeTypeChecker::visitProcedureDecl(ProcedureDeclarationNode* node) {
     std::cout << "[Semantic] Declaring procedure " << node->identifier.value << std::endl;
     
     // Cek apakah sudah dideklarasikan
-    if (isDeclaredInCurrentScope(node->identifier.value)) {
-        throw SemanticError("Procedure '" + node->identifier.value + 
+    if (isDeclaredInCurrentScope(node->identifier.atom)) {
+        throw SemanticError("Procedure '" + node->identifier.text() + 
                           "' already declared in current scope");
     }
     
@@ -226,7 +226,7 @@ void ScopeTypeChecker::visitProcedureDecl(ProcedureDeclarationNode* node) {
     
     // Insert prosedur ke symbol table
     try {
-        int procIdx = symbolTable->insert(node->identifier.value, ObjectKind::PROCEDURE, 
+        int procIdx = symbolTable->insert(node->identifier.atom, ObjectKind::PROCEDURE, 
                                          BaseType::NOTYPE, newBlockIdx, true, 0);
         
         std::cout << "  - Procedure '" << node->identifier.value << "' inserted at index " 
@@ -273,15 +273,15 @@ void ScopeTypeChecker::visitFunctionDecl(FunctionDeclarationNode* node) {
     std::cout << "[Semantic] Declaring function " << node->identifier.value << std::endl;
     
     // Cek apakah sudah dideklarasikan
-    if (isDeclaredInCurrentScope(node->identifier.value)) {
-        throw SemanticError("Function '" + node->identifier.value + 
+    if (isDeclaredInCurrentScope(node->identifier.atom)) {
+        throw SemanticError("Function '" + node->identifier.text() + 
                           "' already declared in current scope");
     }
     
     // Dapatkan return type
     BaseType returnType = BaseType::NOTYPE;
     if (auto* typeNode = dynamic_cast<TypeNode*>(node->pars_return_type.get())) {
-        returnType = getBaseType(typeNode->pars_type_name);
+        returnType = getBaseType(std::string(typeNode->pars_type_name));
     }
     
     // Buat block baru untuk fungsi
@@ -289,7 +289,7 @@ void ScopeTypeChecker::visitFunctionDecl(FunctionDeclarationNode* node) {
     
     // Insert fungsi ke symbol table
     try {
-        int funcIdx = symbolTable->insert(node->identifier.value, ObjectKind::FUNCTION, 
+        int funcIdx = symbolTable->insert(node->identifier.atom, ObjectKind::FUNCTION, 
                                          returnType, newBlockIdx, true, 0);
         
         std::cout << "  - Function '" << node->identifier.value << "' returning " 
@@ -349,7 +349,7 @@ BaseType ScopeTypeChecker::getBaseType(const std::string& typeStr) {
     }
     
     // Cek apakah tipe custom (user-defined)
-    int typeIdx = lookupIdentifier(typeStr);
+    int typeIdx = symbolTable->lookup(typeStr);
     if (typeIdx != -1) {
         TabEntry& entry = symbolTable->get_tab(typeIdx);
         if (entry.obj == ObjectKind::TYPE_ID) {
@@ -378,12 +378,12 @@ int ScopeTypeChecker::getTypeSize(BaseType type) {
     }
 }
 
-bool ScopeTypeChecker::isDeclaredInCurrentScope(const std::string& identifier) {
+bool ScopeTypeChecker::isDeclaredInCurrentScope(Atom identifier) {
     int idx = symbolTable->lookup_current_scope(identifier);
     return idx != -1;
 }
 
-int ScopeTypeChecker::lookupIdentifier(const std::string& identifier) {
+int ScopeTypeChecker::lookupIdentifier(Atom identifier) {
     return symbolTable->lookup(identifier);
 }
 
@@ -424,7 +424,7 @@ int ScopeTypeChecker::processArrayType(const ArrayTypeNode* arrayDef) {
     BaseType elementType = BaseType::NOTYPE;
     
     if (auto* typeNode = dynamic_cast<TypeNode*>(arrayDef->pars_type.get())) {
-        elementType = getBaseType(typeNode->pars_type_name);
+        elementType = getBaseType(std::string(typeNode->pars_type_name));
     }
     
     // Dapatkan range
@@ -457,9 +457,9 @@ void ScopeTypeChecker::visitCompoundStatement(CompoundStatementNode* node) {
 
 void ScopeTypeChecker::visitAssignmentStatement(AssignmentStatementNode* node) {
     // Get type of target variable
-    int idx = lookupIdentifier(node->identifier.value);
+    int idx = lookupIdentifier(node->identifier.atom);
     if (idx == -1) {
-        throw SemanticError("Undeclared variable: " + node->identifier.value);
+        throw SemanticError("Undeclared variable: " + node->identifier.text());
     }
     
     BaseType targetType = symbolTable->get_tab(idx).typ;
@@ -469,7 +469,7 @@ void ScopeTypeChecker::visitAssignmentStatement(AssignmentStatementNode* node) {
     
     // Check compatibility
     if (targetType != exprType && targetType != BaseType::NOTYPE && exprType != BaseType::NOTYPE) {
-        throw SemanticError("Type mismatch in assignment to '" + node->identifier.value + 
+        throw SemanticError("Type mismatch in assignment to '" + node->identifier.text() + 
                           "': expected " + typeToString(targetType) + 
                           " but got " + typeToString(exprType));
     }
@@ -479,9 +479,42 @@ BaseType ScopeTypeChecker::visitExpression(ParseTreeNode* node) {
     if (auto* expr = dynamic_cast<ExpressionNode*>(node)) {
         return visitSimpleExpression(expr->pars_left.get());
     }
+    
+    // compact expression trees (ParserOptions::compact_expressions)
+    if (auto* binary = dynamic_cast<BinaryExpressionNode*>(node)) {
+        return visitBinaryExpression(binary);
+    }
+    if (auto* unary = dynamic_cast<UnaryExpressionNode*>(node)) {
+        // sign keeps the type of its term; tidak is left untyped, as in visitFactor
+        if (unary->op_token.kind == TokenKind::TIDAK) {
+            return BaseType::NOTYPE;
+        }
+        return visitExpression(unary->pars_operand.get());
+    }
+    if (auto* operand = dynamic_cast<TokenNode*>(node)) {
+        return visitOperand(operand->token);
+    }
     return BaseType::NOTYPE;
 }
 
+// same checks as the simple-expression/term walk: the result has the type of
+// the leftmost operand, and only the left side of a comparison is checked
+BaseType ScopeTypeChecker::visitBinaryExpression(BinaryExpressionNode* node) {
+    BaseType leftType = visitExpression(node->pars_left.get());
+    if (is_relational_operator(node->op_token.kind)) {
+        return leftType;
+    }
+    
+    BaseType rightType = visitExpression(node->pars_right.get());
+    if (leftType != rightType && leftType != BaseType::NOTYPE && rightType != BaseType::NOTYPE) {
+        TokenKind op = node->op_token.kind;
+        bool additive = op == TokenKind::PLUS || op == TokenKind::MINUS || op == TokenKind::ATAU;
+        throw SemanticError(std::string(additive ? "Type mismatch in expression" : "Type mismatch in term") +
+                          ": cannot combine " + typeToString(leftType) + " and " + typeToString(rightType));
+    }
+    return leftType;
+}
+
 BaseType ScopeTypeChecker::visitSimpleExpression(ParseTreeNode* node) {
     if (auto* simpleExpr = dynamic_cast<SimpleExpressionNode*>(node)) {
         if (simpleExpr->pars_terms.empty()) {
@@ -532,34 +565,42 @@ BaseType ScopeTypeChecker::visitTerm(ParseTreeNode* node) {
 
 BaseType ScopeTypeChecker::visitFactor(ParseTreeNode* node) {
     if (auto* factor = dynamic_cast<FactorNode*>(node)) {
-        // Handle literals
-        if (factor->token.type == "NUMBER") {
-            return BaseType::INTS;
-        }
-        if (factor->token.type == "CHAR_LITERAL") {
-            return BaseType::CHARS;
-        }
-        if (factor->token.type == "STRING_LITERAL") {
-            return BaseType::CHARS;  // Simplified
+        // Handle literals and identifiers
+        if (factor->token.kind != TokenKind::NONE) {
+            return visitOperand(factor->token);
         }
         
-        // Handle identifiers
-        if (factor->token.type == "IDENTIFIER") {
-            int idx = lookupIdentifier(factor->token.value);
-            if (idx == -1) {
-                throw SemanticError("Undeclared identifier: " + factor->token.value);
-            }
-            return symbolTable->get_tab(idx).typ;
-        }
-        
-        // Handle nested expressions
-        if (factor->pars_expression) {
+        // Handle nested expressions (tidak is not typed yet)
+        if (factor->pars_expression && factor->not_operator.value.empty()) {
             return visitExpression(factor->pars_expression.get());
         }
     }
     return BaseType::NOTYPE;
 }
 
+BaseType ScopeTypeChecker::visitOperand(const Token& token) {
+    // Handle literals
+    if (token.kind == TokenKind::NUMBER) {
+        return BaseType::INTS;
+    }
+    if (token.kind == TokenKind::CHAR_LITERAL) {
+        return BaseType::CHARS;
+    }
+    if (token.kind == TokenKind::STRING_LITERAL) {
+        return BaseType::CHARS;  // Simplified
+    }
+    
+    // Handle identifiers
+    if (token.kind == TokenKind::IDENTIFIER) {
+        int idx = lookupIdentifier(token.atom);
+        if (idx == -1) {
+            throw SemanticError("Undeclared identifier: " + token.text());
+        }
+        return symbolTable->get_tab(idx).typ;
+    }
+    return BaseType::NOTYPE;
+}
+
 std::string ScopeTypeChecker::typeToString(BaseType type) {
     switch (type) {
         case BaseType::INTS: return "integer";
@@ -4,6 +4,9 @@
 
 SymbolTable::SymbolTable() : level(0), t(0), b(0), a(0) {
     display.push_back(0);
+    for (const char* proc : {"write", "writeln", "read", "readln"}) {
+        std_procs.push_back(intern(proc));
+    }
     init_standard_types();
     // Standard procedures like write, writeln, read, readln will be added when first used
     // init_standard_procedures();
@@ -21,7 +24,7 @@ void SymbolTable::init_standard_types() {
     
     for (const auto& word : reserved_words) {
         TabEntry entry;
-        entry.name = word;
+        entry.name = intern(word);
         entry.link = 0;
         entry.obj = ObjectKind::CONSTANT;  // Reserved words as constants
         entry.typ = BaseType::NOTYPE;
@@ -49,9 +52,9 @@ void SymbolTable::init_standard_procedures() {
     insert("readln", ObjectKind::PROCEDURE, BaseType::NOTYPE, 0, true, 0);
 }
 
-int SymbolTable::insert(const std::string& name, ObjectKind obj, BaseType typ, int ref, bool normal, int adr) {
+int SymbolTable::insert(Atom name, ObjectKind obj, BaseType typ, int ref, bool normal, int adr) {
     if (lookup_current_scope(name) != -1) {
-        throw SymbolTableError("Identifier '" + name + "' already declared in current scope");
+        throw SymbolTableError("Identifier '" + std::string(atom_name(name)) + "' already declared in current scope");
     }
     
     TabEntry entry;
@@ -72,11 +75,10 @@ int SymbolTable::insert(const std::string& name, ObjectKind obj, BaseType typ, i
     return idx;
 }
 
-int SymbolTable::lookup(const std::string& name) {
+int SymbolTable::lookup(Atom name) {
     // Auto-insert standard procedures if not found
-    std::vector<std::string> std_procs = {"write", "writeln", "read", "readln"};
     bool is_std_proc = false;
-    for (const auto& proc : std_procs) {
+    for (Atom proc : std_procs) {
         if (name == proc) {
             is_std_proc = true;
             break;
@@ -104,7 +106,7 @@ int SymbolTable::lookup(const std::string& name) {
     return -1;
 }
 
-int SymbolTable::lookup_current_scope(const std::string& name) {
+int SymbolTable::lookup_current_scope(Atom name) {
     int i = btab[display[level]].last;
     while (i > 0) {
         if (tab[i].name == name) {
@@ -115,6 +117,20 @@ int SymbolTable::lookup_current_scope(const std::string& name) {
     return -1;
 }
 
+int SymbolTable::insert(const std::string& name, ObjectKind obj, BaseType typ, int ref, bool normal, int adr) {
+    return insert(intern(name), obj, typ, ref, normal, adr);
+}
+
+int SymbolTable::lookup(const std::string& name) {
+    Atom atom = Interner::global().find(name);
+    return atom == NO_ATOM ? -1 : lookup(atom);
+}
+
+int SymbolTable::lookup_current_scope(const std::string& name) {
+    Atom atom = Interner::global().find(name);
+    return atom == NO_ATOM ? -1 : lookup_current_scope(atom);
+}
+
 void SymbolTable::push_scope() {
     level++;
     int block_idx = enter_block();
@@ -217,7 +233,7 @@ void SymbolTable::print_tab() const {
         }
         
         std::cout << std::setw(4) << i
-                  << std::setw(15) << e.name
+                  << std::setw(15) << atom_name(e.name)
                   << std::setw(6) << e.link
                   << std::setw(12) << obj_str
                   << std::setw(8) << static_cast<int>(e.typ)
@@ -15,15 +15,36 @@ std::string Utils::resolve_from_here(const std::string& p) {
     return p; 
 }
 
-void Utils::print_token(const std::string& type, const std::string& value, const std::string& prefix, bool is_last) {
+void Utils::print_token(std::string_view type, std::string_view value, const std::string& prefix, bool is_last) {
     std::cout << prefix;
     std::cout << (is_last ? "└── " : "├── ");
     std::cout << type << "(" << value << ")\n";
 }
 
+// Restores a prefix buffer to its old length on scope exit
+struct PrefixMark {
+    std::string& prefix;
+    size_t length;
+    ~PrefixMark() { prefix.resize(length); }
+};
+
 void Utils::print_parse_tree(const ParseTreeNode* node, const std::string& prefix, bool is_last, bool is_root) {
+    std::string buffer = prefix;
+    print_tree(node, buffer, is_last, is_root);
+}
+
+// One prefix buffer for the whole walk: each level appends its part and
+// takes it off again on the way out, so the walk allocates nothing once
+// the buffer has grown to the tree's depth.
+void Utils::print_tree(const ParseTreeNode* node, std::string& prefix, bool is_last, bool is_root) {
     if (!node) return;
     
+    // terminals (e.g. compact expression operands) are a single token line
+    if (auto* token_node = dynamic_cast<const TokenNode*>(node)) {
+        print_token(token_node->token.type(), token_node->token.value, prefix, is_last);
+        return;
+    }
+    
     if (is_root) {
         std::cout << node->toString() << "\n";
     } else {
@@ -32,91 +53,96 @@ void Utils::print_parse_tree(const ParseTreeNode* node, const std::string& prefi
         std::cout << node->toString() << "\n";
     }
     
-    std::string new_prefix = prefix;
+    PrefixMark mark{prefix, prefix.size()};
     if (!is_root) {
-        new_prefix += (is_last ? "    " : "│   ");
+        prefix += (is_last ? "    " : "│   ");
     }
+    std::string& new_prefix = prefix;
     
     if (auto* prog_header = dynamic_cast<const ProgramHeaderNode*>(node)) {
-        print_token(prog_header->program_keyword.type, prog_header->program_keyword.value, new_prefix, false);
-        print_token(prog_header->program_name.type, prog_header->program_name.value, new_prefix, false);
-        print_token(prog_header->semicolon.type, prog_header->semicolon.value, new_prefix, true);
+        print_token(prog_header->program_keyword.type(), prog_header->program_keyword.value, new_prefix, false);
+        print_token(prog_header->program_name.type(), prog_header->program_name.value, new_prefix, false);
+        print_token(prog_header->semicolon.type(), prog_header->semicolon.value, new_prefix, true);
         return;
     }
     
     if (auto* var_decl = dynamic_cast<const VariableDeclarationNode*>(node)) {
-        print_token(var_decl->var_keyword.type, var_decl->var_keyword.value, new_prefix, false);
+        print_token(var_decl->var_keyword.type(), var_decl->var_keyword.value, new_prefix, false);
         
         if (var_decl->pars_identifier_list) {
             std::cout << new_prefix << "├── <identifier-list>\n";
-            std::string id_prefix = new_prefix + "│   ";
+            PrefixMark id_mark{new_prefix, new_prefix.size()};
+            new_prefix += "│   ";
+            const std::string& id_prefix = new_prefix;
             auto& id_list = var_decl->pars_identifier_list;
             for (size_t i = 0; i < id_list->identifier_tokens.size(); i++) {
                 bool is_last_id = (i == id_list->identifier_tokens.size() - 1 && 
                                    i >= id_list->comma_tokens.size());
-                print_token(id_list->identifier_tokens[i].type, 
+                print_token(id_list->identifier_tokens[i].type(), 
                            id_list->identifier_tokens[i].value, 
                            id_prefix, is_last_id);
                 if (i < id_list->comma_tokens.size()) {
-                    print_token(id_list->comma_tokens[i].type, 
+                    print_token(id_list->comma_tokens[i].type(), 
                                id_list->comma_tokens[i].value, 
                                id_prefix, false);
                 }
             }
         }
         
-        print_token(var_decl->colon.type, var_decl->colon.value, new_prefix, false);
+        print_token(var_decl->colon.type(), var_decl->colon.value, new_prefix, false);
         
         // print type
         if (var_decl->pars_type) {
-            print_parse_tree(var_decl->pars_type.get(), new_prefix, false, false);
+            print_tree(var_decl->pars_type.get(), new_prefix, false, false);
         }
         
-        print_token(var_decl->semicolon.type, var_decl->semicolon.value, new_prefix, true);
+        print_token(var_decl->semicolon.type(), var_decl->semicolon.value, new_prefix, true);
         return;
     }
 
     if (auto* type_node = dynamic_cast<const TypeNode*>(node)) {
-        print_token(type_node->type_keyword.type, type_node->type_keyword.value, new_prefix, true);
+        print_token(type_node->type_keyword.type(), type_node->type_keyword.value, new_prefix, true);
         return;
     }
 
     if (auto* array_node = dynamic_cast<const ArrayTypeNode*>(node)) {
-        print_token(array_node->array_keyword.type, array_node->array_keyword.value, new_prefix, false);
-        print_token(array_node->lbracket.type, array_node->lbracket.value, new_prefix, false);
+        print_token(array_node->array_keyword.type(), array_node->array_keyword.value, new_prefix, false);
+        print_token(array_node->lbracket.type(), array_node->lbracket.value, new_prefix, false);
         if (array_node->pars_range) {
-            print_parse_tree(array_node->pars_range.get(), new_prefix, false, false);
+            print_tree(array_node->pars_range.get(), new_prefix, false, false);
         }
-        print_token(array_node->rbracket.type, array_node->rbracket.value, new_prefix, false);
-        print_token(array_node->of_keyword.type, array_node->of_keyword.value, new_prefix, false);
+        print_token(array_node->rbracket.type(), array_node->rbracket.value, new_prefix, false);
+        print_token(array_node->of_keyword.type(), array_node->of_keyword.value, new_prefix, false);
         if (array_node->pars_type) {
-            print_parse_tree(array_node->pars_type.get(), new_prefix, true, false);
+            print_tree(array_node->pars_type.get(), new_prefix, true, false);
         }
         return;
     }
     
     if (auto* range_node = dynamic_cast<const RangeNode*>(node)) {
         if (range_node->pars_start_expression) {
-            print_parse_tree(range_node->pars_start_expression.get(), new_prefix, false, false);
+            print_tree(range_node->pars_start_expression.get(), new_prefix, false, false);
         }
-        print_token(range_node->range_operator.type, range_node->range_operator.value, new_prefix, false);
+        print_token(range_node->range_operator.type(), range_node->range_operator.value, new_prefix, false);
         if (range_node->pars_end_expression) {
-            print_parse_tree(range_node->pars_end_expression.get(), new_prefix, true, false);
+            print_tree(range_node->pars_end_expression.get(), new_prefix, true, false);
         }
         return;
     }
     
     if (auto* compound = dynamic_cast<const CompoundStatementNode*>(node)) {
-        print_token(compound->mulai_keyword.type, compound->mulai_keyword.value, new_prefix, false);
+        print_token(compound->mulai_keyword.type(), compound->mulai_keyword.value, new_prefix, false);
         
         if (!compound->pars_statement_list.empty()) {
             std::cout << new_prefix << "├── " << "<statement-list>" << "\n";
-            std::string stmt_list_prefix = new_prefix + "│   ";
+            PrefixMark stmt_list_mark{new_prefix, new_prefix.size()};
+            new_prefix += "│   ";
+            std::string& stmt_list_prefix = new_prefix;
             
             for (size_t i = 0; i < compound->pars_statement_list.size(); i++) {
                 auto* stmt = compound->pars_statement_list[i].get();
                 if (auto* token_node = dynamic_cast<const TokenNode*>(stmt)) {
-                    if (token_node->token.type == "SEMICOLON") {
+                    if (token_node->token.kind == TokenKind::SEMICOLON) {
                         std::cout << stmt_list_prefix << (i == compound->pars_statement_list.size() - 1 ? "└── " : "├── ");
                         std::cout << "SEMICOLON(;)" << "\n";
                         continue; 
@@ -124,80 +150,80 @@ void Utils::print_parse_tree(const ParseTreeNode* node, const std::string& prefi
                 }
                 
                 bool is_last = (i == compound->pars_statement_list.size() - 1);
-                print_parse_tree(stmt, stmt_list_prefix, is_last, false);
+                print_tree(stmt, stmt_list_prefix, is_last, false);
             }
         }
         
-        print_token(compound->selesai_keyword.type, compound->selesai_keyword.value, new_prefix, true);
+        print_token(compound->selesai_keyword.type(), compound->selesai_keyword.value, new_prefix, true);
         return;
     }
     
     if (auto* assign = dynamic_cast<const AssignmentStatementNode*>(node)) {
-        print_token(assign->identifier.type, assign->identifier.value, new_prefix, false);
-        print_token(assign->assign_operator.type, assign->assign_operator.value, new_prefix, false);
+        print_token(assign->identifier.type(), assign->identifier.value, new_prefix, false);
+        print_token(assign->assign_operator.type(), assign->assign_operator.value, new_prefix, false);
         if (assign->pars_expression) {
-            print_parse_tree(assign->pars_expression.get(), new_prefix, true, false);
+            print_tree(assign->pars_expression.get(), new_prefix, true, false);
         }
         return;
     }
     
     if (auto* if_stmt = dynamic_cast<const IfStatementNode*>(node)) {
-        print_token(if_stmt->if_keyword.type, if_stmt->if_keyword.value, new_prefix, false);
+        print_token(if_stmt->if_keyword.type(), if_stmt->if_keyword.value, new_prefix, false);
         if (if_stmt->pars_condition) {
-            print_parse_tree(if_stmt->pars_condition.get(), new_prefix, false, false);
+            print_tree(if_stmt->pars_condition.get(), new_prefix, false, false);
         }
-        print_token(if_stmt->then_keyword.type, if_stmt->then_keyword.value, new_prefix, false);
+        print_token(if_stmt->then_keyword.type(), if_stmt->then_keyword.value, new_prefix, false);
         if (if_stmt->pars_then_statement) {
             bool has_else = if_stmt->pars_else_statement != nullptr;
-            print_parse_tree(if_stmt->pars_then_statement.get(), new_prefix, !has_else, false);
+            print_tree(if_stmt->pars_then_statement.get(), new_prefix, !has_else, false);
         }
         if (if_stmt->pars_else_statement) {
-            print_token(if_stmt->else_keyword.type, if_stmt->else_keyword.value, new_prefix, false);
-            print_parse_tree(if_stmt->pars_else_statement.get(), new_prefix, true, false);
+            print_token(if_stmt->else_keyword.type(), if_stmt->else_keyword.value, new_prefix, false);
+            print_tree(if_stmt->pars_else_statement.get(), new_prefix, true, false);
         }
         return;
     }
     
     if (auto* while_stmt = dynamic_cast<const WhileStatementNode*>(node)) {
-        print_token(while_stmt->while_keyword.type, while_stmt->while_keyword.value, new_prefix, false);
+        print_token(while_stmt->while_keyword.type(), while_stmt->while_keyword.value, new_prefix, false);
         if (while_stmt->pars_condition) {
-            print_parse_tree(while_stmt->pars_condition.get(), new_prefix, false, false);
+            print_tree(while_stmt->pars_condition.get(), new_prefix, false, false);
         }
-        print_token(while_stmt->do_keyword.type, while_stmt->do_keyword.value, new_prefix, false);
+        print_token(while_stmt->do_keyword.type(), while_stmt->do_keyword.value, new_prefix, false);
         if (while_stmt->pars_body) {
-            print_parse_tree(while_stmt->pars_body.get(), new_prefix, true, false);
+            print_tree(while_stmt->pars_body.get(), new_prefix, true, false);
         }
         return;
     }
     
     if (auto* for_node = dynamic_cast<const ForStatementNode*>(node)) {
-        print_token(for_node->for_keyword.type, for_node->for_keyword.value, new_prefix, false);
-        print_token(for_node->control_variable.type, for_node->control_variable.value, new_prefix, false);
-        print_token(for_node->assign_operator.type, for_node->assign_operator.value, new_prefix, false);
+        print_token(for_node->for_keyword.type(), for_node->for_keyword.value, new_prefix, false);
+        print_token(for_node->control_variable.type(), for_node->control_variable.value, new_prefix, false);
+        print_token(for_node->assign_operator.type(), for_node->assign_operator.value, new_prefix, false);
         if (for_node->pars_initial_value) {
-            print_parse_tree(for_node->pars_initial_value.get(), new_prefix, false, false);
+            print_tree(for_node->pars_initial_value.get(), new_prefix, false, false);
         }
-        print_token(for_node->direction_keyword.type, for_node->direction_keyword.value, new_prefix, false);
+        print_token(for_node->direction_keyword.type(), for_node->direction_keyword.value, new_prefix, false);
         if (for_node->pars_final_value) {
-            print_parse_tree(for_node->pars_final_value.get(), new_prefix, false, false);
+            print_tree(for_node->pars_final_value.get(), new_prefix, false, false);
         }
-        print_token(for_node->do_keyword.type, for_node->do_keyword.value, new_prefix, false);
+        print_token(for_node->do_keyword.type(), for_node->do_keyword.value, new_prefix, false);
         if (for_node->pars_body) {
-            print_parse_tree(for_node->pars_body.get(), new_prefix, true, false);
+            print_tree(for_node->pars_body.get(), new_prefix, true, false);
         }
         return;
     }
     
     if (auto* proc_call = dynamic_cast<const ProcedureFunctionCallNode*>(node)) {
-        print_token(proc_call->procedure_name.type, proc_call->procedure_name.value, new_prefix, false);
+        print_token(proc_call->procedure_name.type(), proc_call->procedure_name.value, new_prefix, false);
         if (!proc_call->lparen.value.empty()) {
-            print_token(proc_call->lparen.type, proc_call->lparen.value, new_prefix, false);
+            print_token(proc_call->lparen.type(), proc_call->lparen.value, new_prefix, false);
         }
         if (proc_call->pars_parameter_list) {
-            print_parse_tree(proc_call->pars_parameter_list.get(), new_prefix, false, false);
+            print_tree(proc_call->pars_parameter_list.get(), new_prefix, false, false);
         }
         if (!proc_call->rparen.value.empty()) {
-            print_token(proc_call->rparen.type, proc_call->rparen.value, new_prefix, true);
+            print_token(proc_call->rparen.type(), proc_call->rparen.value, new_prefix, true);
         }
         return;
     }
@@ -205,9 +231,9 @@ void Utils::print_parse_tree(const ParseTreeNode* node, const std::string& prefi
     if (auto* param_list = dynamic_cast<const ParameterListNode*>(node)) {
         for (size_t i = 0; i < param_list->pars_parameters.size(); i++) {
             bool is_last_param = (i == param_list->pars_parameters.size() - 1);
-            print_parse_tree(param_list->pars_parameters[i].get(), new_prefix, is_last_param, false);
+            print_tree(param_list->pars_parameters[i].get(), new_prefix, is_last_param, false);
             if (i < param_list->comma_tokens.size()) {
-                print_token(param_list->comma_tokens[i].type, 
+                print_token(param_list->comma_tokens[i].type(), 
                            param_list->comma_tokens[i].value, new_prefix, false);
             }
         }
@@ -217,26 +243,26 @@ void Utils::print_parse_tree(const ParseTreeNode* node, const std::string& prefi
     if (auto* expr = dynamic_cast<const ExpressionNode*>(node)) {
         if (expr->pars_left) {
             bool has_right = expr->pars_right != nullptr;
-            print_parse_tree(expr->pars_left.get(), new_prefix, !has_right, false);
+            print_tree(expr->pars_left.get(), new_prefix, !has_right, false);
         }
         if (expr->pars_relational_op) {
-            print_parse_tree(expr->pars_relational_op.get(), new_prefix, false, false);
+            print_tree(expr->pars_relational_op.get(), new_prefix, false, false);
         }
         if (expr->pars_right) {
-            print_parse_tree(expr->pars_right.get(), new_prefix, true, false);
+            print_tree(expr->pars_right.get(), new_prefix, true, false);
         }
         return;
     }
     
     if (auto* simple_expr = dynamic_cast<const SimpleExpressionNode*>(node)) {
         if (!simple_expr->sign.value.empty()) {
-            print_token(simple_expr->sign.type, simple_expr->sign.value, new_prefix, false);
+            print_token(simple_expr->sign.type(), simple_expr->sign.value, new_prefix, false);
         }
         for (size_t i = 0; i < simple_expr->pars_terms.size(); i++) {
             bool is_last_term = (i == simple_expr->pars_terms.size() - 1 && i >= simple_expr->pars_operators.size());
-            print_parse_tree(simple_expr->pars_terms[i].get(), new_prefix, is_last_term, false);
+            print_tree(simple_expr->pars_terms[i].get(), new_prefix, is_last_term, false);
             if (i < simple_expr->pars_operators.size()) {
-                print_parse_tree(simple_expr->pars_operators[i].get(), new_prefix, 
+                print_tree(simple_expr->pars_operators[i].get(), new_prefix, 
                                i == simple_expr->pars_operators.size() - 1, false);
             }
         }
@@ -246,9 +272,9 @@ void Utils::print_parse_tree(const ParseTreeNode* node, const std::string& prefi
     if (auto* term = dynamic_cast<const TermNode*>(node)) {
         for (size_t i = 0; i < term->pars_factors.size(); i++) {
             bool is_last_factor = (i == term->pars_factors.size() - 1 && i >= term->pars_operators.size());
-            print_parse_tree(term->pars_factors[i].get(), new_prefix, is_last_factor, false);
+            print_tree(term->pars_factors[i].get(), new_prefix, is_last_factor, false);
             if (i < term->pars_operators.size()) {
-                print_parse_tree(term->pars_operators[i].get(), new_prefix, 
+                print_tree(term->pars_operators[i].get(), new_prefix, 
                                i == term->pars_operators.size() - 1, false);
             }
         }
@@ -257,36 +283,42 @@ void Utils::print_parse_tree(const ParseTreeNode* node, const std::string& prefi
     
     if (auto* factor = dynamic_cast<const FactorNode*>(node)) {
         if (!factor->not_operator.value.empty()) {
-            print_token(factor->not_operator.type, factor->not_operator.value, new_prefix, false);
+            print_token(factor->not_operator.type(), factor->not_operator.value, new_prefix, false);
             if (factor->pars_expression) {
-                print_parse_tree(factor->pars_expression.get(), new_prefix, true, false);
+                print_tree(factor->pars_expression.get(), new_prefix, true, false);
             }
             return;
         }
         
         if (factor->pars_procedure_function_call) {
-            print_parse_tree(factor->pars_procedure_function_call.get(), new_prefix, true, false);
+            print_tree(factor->pars_procedure_function_call.get(), new_prefix, true, false);
             return;
         }
         
         if (factor->pars_expression) {
-            print_parse_tree(factor->pars_expression.get(), new_prefix, true, false);
+            print_tree(factor->pars_expression.get(), new_prefix, true, false);
             return;
         }
         
         if (!factor->token.value.empty()) {
-            print_token(factor->token.type, factor->token.value, new_prefix, true);
+            print_token(factor->token.type(), factor->token.value, new_prefix, true);
             return;
         }
         return;
     }
     
-    if (auto* token_node = dynamic_cast<const TokenNode*>(node)) {
-        print_token(token_node->token.type, token_node->token.value, new_prefix, is_last);
+    if (auto* binary = dynamic_cast<const BinaryExpressionNode*>(node)) {
+        print_tree(binary->pars_left.get(), new_prefix, false, false);
+        print_token(binary->op_token.type(), binary->op_token.value, new_prefix, false);
+        print_tree(binary->pars_right.get(), new_prefix, true, false);
         return;
     }
     
-    auto children = node->getChildren();
+    if (auto* unary = dynamic_cast<const UnaryExpressionNode*>(node)) {
+        print_token(unary->op_token.type(), unary->op_token.value, new_prefix, false);
+        print_tree(unary->pars_operand.get(), new_prefix, true, false);
+        return;
+    }
     
     bool has_dot_token = false;
     if (is_root) {
@@ -295,14 +327,18 @@ void Utils::print_parse_tree(const ParseTreeNode* node, const std::string& prefi
         }
     }
     
-    for (size_t i = 0; i < children.size(); i++) {
-        bool child_is_last = (i == children.size() - 1) && !has_dot_token;
-        print_parse_tree(children[i], new_prefix, child_is_last, false);
-    }
+    // each child is printed once the next one shows up, so the last one is
+    // known without collecting them first
+    const ParseTreeNode* pending = nullptr;
+    node->forEachChild([&](ParseTreeNode* child) {
+        if (pending) print_tree(pending, new_prefix, false, false);
+        pending = child;
+    });
+    if (pending) print_tree(pending, new_prefix, !has_dot_token, false);
     
     if (is_root && has_dot_token) {
         if (auto* prog = dynamic_cast<const ProgramNode*>(node)) {
-            std::cout << "└── " << prog->dot_token.type << "(" << prog->dot_token.value << ")\n";
+            std::cout << "└── " << prog->dot_token.type() << "(" << prog->dot_token.value << ")\n";
         }
     }
 }
\ No newline at end of file
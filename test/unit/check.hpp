@@ -0,0 +1,27 @@
+#pragma once
+#include <iostream>
+
+// Minimal assertions for the unit test programs under test/unit: a failed
+// CHECK is reported and counted, and main returns test_result().
+inline int &test_failures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(cond)                                                                  \
+    do {                                                                             \
+        if (!(cond)) {                                                               \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #cond "\n"; \
+            ++test_failures();                                                       \
+        }                                                                            \
+    } while (0)
+
+inline int test_result()
+{
+    if (test_failures() != 0) {
+        std::cerr << test_failures() << " check(s) failed\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,115 @@
+// Lexical errors are collected as LexDiagnostics and thrown together; an
+// error limit (max_errors / fail_fast) stops lexing early and says so.
+#include "lexer/lexer.hpp"
+#include "check.hpp"
+#include <string>
+#include <vector>
+
+// four errors: three stray bytes and an unterminated comment at the end
+static const std::string SOURCE = "program p;\n"
+                                  "mulai\n"
+                                  "  x := 1 @ 2;\n"
+                                  "  y := #;\n"
+                                  "  z := ? + 3;\n"
+                                  "selesai. { never closed";
+
+struct Outcome
+{
+    bool threw = false;
+    std::vector<LexDiagnostic> diags;
+    bool stopped = false;
+    std::string message;
+    size_t tokens_before_throw = 0; // next_token() calls that returned
+};
+
+static Outcome lex(const LexerOptions &options)
+{
+    Lexer lexer(SOURCE);
+    lexer.set_options(options);
+    Outcome out;
+    try {
+        while (lexer.next_token().kind != TokenKind::NONE) ++out.tokens_before_throw;
+    } catch (const LexerError &e) {
+        out.threw = true;
+        out.diags = e.diagnostics();
+        out.stopped = e.stopped_early();
+        out.message = e.what();
+    }
+    return out;
+}
+
+static LexerOptions max_errors(size_t n)
+{
+    LexerOptions options;
+    options.max_errors = n;
+    return options;
+}
+
+int main()
+{
+    const uint32_t at = static_cast<uint32_t>(SOURCE.find('@'));
+    const uint32_t hash = static_cast<uint32_t>(SOURCE.find('#'));
+    const uint32_t question = static_cast<uint32_t>(SOURCE.find('?'));
+    const uint32_t brace = static_cast<uint32_t>(SOURCE.find('{'));
+
+    // no limit: every error, in source order, after the whole source
+    Outcome all = lex(LexerOptions{});
+    CHECK(all.threw);
+    CHECK(!all.stopped);
+    CHECK(all.diags.size() == 4);
+    if (all.diags.size() == 4) {
+        CHECK(all.diags[0].code == LexErrorCode::UNEXPECTED_CHARACTER && all.diags[0].offset == at);
+        CHECK(all.diags[1].code == LexErrorCode::UNEXPECTED_CHARACTER && all.diags[1].offset == hash);
+        CHECK(all.diags[2].code == LexErrorCode::UNEXPECTED_CHARACTER && all.diags[2].offset == question);
+        CHECK(all.diags[3].code == LexErrorCode::UNTERMINATED_BRACE_COMMENT && all.diags[3].offset == brace);
+        CHECK(all.diags[3].offset + all.diags[3].length == SOURCE.size());
+    }
+    CHECK(all.message.find("(4)") != std::string::npos);
+    CHECK(all.message.find("stopped at the error limit") == std::string::npos);
+
+    // max_errors = 0 is no limit too
+    Outcome zero = lex(max_errors(0));
+    CHECK(zero.diags.size() == 4 && !zero.stopped);
+
+    // a limit below the error count keeps the first n and stops early,
+    // before the tokens after the n-th error are produced
+    Outcome two = lex(max_errors(2));
+    CHECK(two.threw);
+    CHECK(two.stopped);
+    CHECK(two.diags.size() == 2);
+    if (two.diags.size() == 2) CHECK(two.diags[0].offset == at && two.diags[1].offset == hash);
+    CHECK(two.message.find("stopped at the error limit") != std::string::npos);
+    CHECK(two.tokens_before_throw < all.tokens_before_throw);
+
+    // reaching the limit exactly on the last error still counts as stopping
+    Outcome four = lex(max_errors(4));
+    CHECK(four.diags.size() == 4 && four.stopped);
+    // a limit above the error count changes nothing
+    Outcome many = lex(max_errors(100));
+    CHECK(many.diags.size() == 4 && !many.stopped);
+
+    // fail_fast: the first error only, thrown before any token after it
+    LexerOptions fast;
+    fast.fail_fast = true;
+    Outcome first = lex(fast);
+    CHECK(first.threw);
+    CHECK(first.stopped);
+    CHECK(first.diags.size() == 1);
+    if (first.diags.size() == 1) CHECK(first.diags[0].offset == at);
+    CHECK(first.tokens_before_throw <= two.tokens_before_throw);
+    // fail_fast wins over a larger max_errors
+    fast.max_errors = 3;
+    CHECK(lex(fast).diags.size() == 1);
+
+    // tokenize() reports the same as streaming
+    Lexer lexer(SOURCE);
+    lexer.set_options(max_errors(2));
+    try {
+        lexer.tokenize();
+        CHECK(false);
+    } catch (const LexerError &e) {
+        CHECK(e.diagnostics().size() == 2 && e.stopped_early());
+    }
+
+    return test_result();
+}
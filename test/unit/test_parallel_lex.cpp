@@ -0,0 +1,101 @@
+// tokenize_parallel must give exactly what tokenize() gives. The chunk size
+// is forced down so the sources below are split on nearly every line, and
+// chunks start inside comments, strings and errors.
+#include "lexer/lexer.hpp"
+#include "check.hpp"
+#include <string>
+#include <vector>
+
+struct LexResult
+{
+    std::vector<Token> tokens;
+    bool failed = false;
+    std::string message;
+    std::vector<LexDiagnostic> diags;
+    bool stopped = false;
+};
+
+static LexResult lex(const std::string &src, unsigned threads, LexerOptions options = {})
+{
+    options.parallel_min_chunk = 1;
+    Lexer lexer(src);
+    lexer.set_options(options);
+    LexResult r;
+    try {
+        r.tokens = threads == 0 ? lexer.tokenize() : lexer.tokenize_parallel(threads);
+    } catch (const LexerError &e) {
+        r.failed = true;
+        r.message = e.what();
+        r.diags = e.diagnostics();
+        r.stopped = e.stopped_early();
+    }
+    return r;
+}
+
+static bool same_tokens(const std::vector<Token> &a, const std::vector<Token> &b)
+{
+    if (a.size() != b.size()) return false;
+    for (size_t k = 0; k < a.size(); ++k) {
+        if (a[k].kind != b[k].kind || a[k].offset != b[k].offset || a[k].value != b[k].value ||
+            a[k].line != b[k].line || a[k].column != b[k].column || a[k].atom != b[k].atom)
+            return false;
+    }
+    return true;
+}
+
+static bool same_diags(const std::vector<LexDiagnostic> &a, const std::vector<LexDiagnostic> &b)
+{
+    if (a.size() != b.size()) return false;
+    for (size_t k = 0; k < a.size(); ++k) {
+        if (a[k].code != b[k].code || a[k].offset != b[k].offset || a[k].length != b[k].length) return false;
+    }
+    return true;
+}
+
+static void check_same_as_serial(const std::string &src, LexerOptions options = {})
+{
+    LexResult serial = lex(src, 0, options);
+    for (unsigned threads = 2; threads <= 8; ++threads) {
+        LexResult parallel = lex(src, threads, options);
+        CHECK(parallel.failed == serial.failed);
+        CHECK(same_tokens(parallel.tokens, serial.tokens));
+        CHECK(parallel.message == serial.message);
+        CHECK(same_diags(parallel.diags, serial.diags));
+        CHECK(parallel.stopped == serial.stopped);
+    }
+}
+
+int main()
+{
+    const std::string head = "program p;\nvariabel x, y: integer;\nmulai\n";
+    const std::string tail = "  x := x + 1;\n  y := x * 2\nselesai.\n";
+
+    // chunks starting inside a { } and a (* *) comment
+    check_same_as_serial(head + "  { x := 1;\n  y := 2;\n  z := 3; }\n" + tail);
+    check_same_as_serial(head + "  (* x := 1;\n  * y := 2;\n  z := 3 *)\n" + tail);
+    // a comment whose first line looks like code: the speculative chunk
+    // lexes tokens that are really comment text
+    check_same_as_serial(head + "  {\nx := 'a';\n(* y\n}\n" + tail);
+
+    // chunks starting inside a string that runs across lines
+    check_same_as_serial(head + "  x := 'first\n  x := second\n  y := third';\n" + tail);
+    check_same_as_serial(head + "  x := '\n';\n  y := '\n\n\n';\n" + tail);
+
+    // chunks starting inside an error: an unterminated comment or string
+    // swallows the rest of the source, and stray bytes between lines
+    check_same_as_serial(head + "  { never closed\n" + tail);
+    check_same_as_serial(head + "  (* never closed\n" + tail);
+    check_same_as_serial(head + "  x := 'never closed\n" + tail);
+    check_same_as_serial(head + "  x := 1 @\n# y := 2;\n  ? z\n" + tail);
+
+    // error limits cut the stream at the same point
+    const std::string many_errors = head + "  @\n  x := 1;\n  #\n  ?\n  y := 2;\n  @\n" + tail;
+    LexerOptions limited;
+    limited.max_errors = 2;
+    check_same_as_serial(many_errors, limited);
+    LexerOptions fail_fast;
+    fail_fast.fail_fast = true;
+    check_same_as_serial(many_errors, fail_fast);
+
+    return test_result();
+}
@@ -0,0 +1,98 @@
+// Lexer::relex after an edit must leave the token stream exactly as a full
+// tokenize() of the edited text would, and reject edits that do not fit.
+#include "lexer/lexer.hpp"
+#include "check.hpp"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+static bool same_tokens(const std::vector<Token> &a, const std::vector<Token> &b)
+{
+    if (a.size() != b.size()) return false;
+    for (size_t k = 0; k < a.size(); ++k) {
+        if (a[k].kind != b[k].kind || a[k].offset != b[k].offset || a[k].value != b[k].value ||
+            a[k].line != b[k].line || a[k].column != b[k].column || a[k].atom != b[k].atom)
+            return false;
+        // rebased tokens must view into the new text, not the old one
+        if (a[k].value.data() != b[k].value.data()) return false;
+    }
+    return true;
+}
+
+// replaces `removed` bytes at `offset` of before with `inserted` and relexes
+static void check_edit(const std::string &before, size_t offset, size_t removed, const std::string &inserted)
+{
+    std::string after = before.substr(0, offset) + inserted + before.substr(offset + removed);
+
+    Lexer old_lexer(before);
+    std::vector<Token> tokens = old_lexer.tokenize();
+
+    Lexer lexer(after);
+    TokenRange range = lexer.relex(tokens, SourceEdit{offset, removed, after.substr(offset, inserted.size())});
+    Lexer full(after);
+    std::vector<Token> expected = full.tokenize();
+    CHECK(same_tokens(tokens, expected));
+    CHECK(range.first + range.inserted <= tokens.size());
+}
+
+static bool rejects(const std::string &before, const std::string &after, SourceEdit edit)
+{
+    Lexer old_lexer(before);
+    std::vector<Token> tokens = old_lexer.tokenize();
+    const size_t count = tokens.size();
+    Lexer lexer(after);
+    try {
+        lexer.relex(tokens, edit);
+    } catch (const std::invalid_argument &) {
+        return tokens.size() == count; // left alone
+    }
+    return false;
+}
+
+int main()
+{
+    const std::string src = "program p;\n"
+                            "variabel x: integer; { counter }\n"
+                            "mulai\n"
+                            "  x := 'hello world';\n"
+                            "  y := x + 12\n"
+                            "selesai.";
+
+    // inside a comment: only whitespace/comment changes, no token does
+    size_t comment = src.find("counter");
+    check_edit(src, comment, 7, "loop counter");
+    check_edit(src, comment, 0, "x := 1; ");
+    // ... and one that closes the comment early, turning its tail into tokens
+    check_edit(src, comment, 0, "} y := 2; {");
+
+    // inside a string: the literal is relexed as one token
+    size_t str = src.find("world");
+    check_edit(src, str, 5, "there");
+    check_edit(src, str, 0, "big ");
+    // ... and one that ends the string early
+    check_edit(src, str, 0, "' + '");
+
+    // across the boundary between two tokens
+    size_t plus = src.find(" + 12");
+    check_edit(src, plus, 3, "");       // "x12": two tokens merge into one
+    check_edit(src, plus - 1, 2, "ab"); // replaces the end of x and the space
+    size_t assign = src.find(":= 'hello");
+    check_edit(src, assign, 1, "");     // ":=" loses its ':'
+    check_edit(src, src.find("x: integer") + 1, 0, " "); // "x:" split apart
+
+    // deleting at the end of the file
+    check_edit(src, src.size() - 1, 1, "");              // the final '.'
+    check_edit(src, src.find("selesai."), 8, "");        // the last token(s)
+    check_edit(src, src.find("\nselesai."), 9, "");      // everything after the last statement
+    check_edit(src, src.size(), 0, " { trailing }");     // appending at EOF
+    check_edit(src + "   ", src.size(), 3, "");          // trailing blanks only
+
+    // invalid edits throw std::invalid_argument and leave the tokens alone
+    std::string shorter = src.substr(0, src.size() - 1);
+    CHECK(rejects(src, shorter, SourceEdit{shorter.size(), 0, ""}));          // removed understated at EOF
+    CHECK(rejects(src, src, SourceEdit{src.size() + 1, 0, ""}));              // offset past the end
+    CHECK(rejects(src, src, SourceEdit{3, 0, "xyz"}));                        // inserted text not in the source
+    CHECK(rejects(src, src, SourceEdit{0, static_cast<size_t>(-1), ""}));    // removed overflows
+
+    return test_result();
+}
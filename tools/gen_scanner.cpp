@@ -0,0 +1,178 @@
+// Generates a switch/goto C++ scanner from a DFA description.
+// usage: gen_scanner <dfa.json|dfa.txt> <output.cpp>
+//
+// Every DFA state becomes a label; each byte dispatches through a switch
+// straight to the label of the next state, so the C++ compiler can keep the
+// cursor in registers instead of indexing a transition table. The output also
+// carries the dense tables themselves (builtin_dfa), with the same state ids.
+#include "lexer/dfa_loader.hpp"
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+static bool ends_with(const std::string& s, const std::string& suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+static std::string byte_label(int b) {
+    if (b >= 0x21 && b < 0x7f && b != '\'' && b != '\\' && b != '*' && b != '/') {
+        return std::string(" /* ") + static_cast<char>(b) + " */";
+    }
+    return "";
+}
+
+// State names come from the DFA file, so they are escaped before being
+// written into the generated source
+static std::string string_literal(std::string_view name) {
+    std::string out = "\"";
+    for (unsigned char c : name) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += static_cast<char>(c);
+        } else if (c < 0x20 || c >= 0x7f) {
+            // octal, so a following hex digit is not swallowed into the escape
+            out += '\\';
+            out += static_cast<char>('0' + (c >> 6));
+            out += static_cast<char>('0' + ((c >> 3) & 7));
+            out += static_cast<char>('0' + (c & 7));
+        } else {
+            out += static_cast<char>(c);
+        }
+    }
+    return out + "\"";
+}
+
+// a newline or trailing backslash would end or continue a // comment
+static std::string comment_text(std::string_view name) {
+    std::string out;
+    for (unsigned char c : name) out += (c < 0x20 || c >= 0x7f || c == '\\') ? '?' : static_cast<char>(c);
+    return out;
+}
+
+// S_<id> is entered right after consuming a byte; L_<id> (start state only)
+// skips the accept bookkeeping. Labels nothing jumps to are left out.
+static void emit_state(std::ostream& out, const CompiledDFA& dfa, int s, bool targeted) {
+    out << "    // " << comment_text(dfa.name(s)) << "\n";
+    if (targeted) out << "S_" << s << ":\n";
+    if (dfa.is_final(s)) {
+        out << "    m.state = " << s << ";\n";
+        out << "    m.end = i;\n";
+    }
+    if (s == dfa.start()) out << "L_" << s << ":\n";
+
+    // group bytes by target state
+    std::map<int, std::vector<int>> by_target;
+    for (int b = 0; b < 256; ++b) {
+        int t = dfa.next(s, static_cast<unsigned char>(b));
+        if (t != CompiledDFA::DEAD) by_target[t].push_back(b);
+    }
+    if (by_target.empty()) {
+        out << "    goto done;\n\n";
+        return;
+    }
+
+    out << "    if (i >= n) goto done;\n";
+    out << "    switch (p[i]) {\n";
+    for (const auto& kv : by_target) {
+        int on_line = 0;
+        for (int b : kv.second) {
+            if (on_line == 6) {
+                out << "\n";
+                on_line = 0;
+            }
+            out << (on_line == 0 ? "    " : " ") << "case " << b << byte_label(b) << ":";
+            ++on_line;
+        }
+        out << "\n        ++i; goto S_" << kv.first << ";\n";
+    }
+    out << "    default: goto done;\n";
+    out << "    }\n\n";
+}
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "usage: " << argv[0] << " <dfa.json|dfa.txt> <output.cpp>\n";
+        return 1;
+    }
+    std::string in_path = argv[1];
+
+    CompiledDFA dfa;
+    try {
+        DFA raw = ends_with(in_path, ".txt") ? load_dfa_txt(in_path) : load_dfa_json(in_path);
+        DFAReport report;
+        dfa = minimize_dfa(raw.compile(), &report);
+        for (const auto& s : report.unreachable) std::cerr << "gen_scanner: warning: state " << s << " is unreachable\n";
+        for (const auto& s : report.dead) std::cerr << "gen_scanner: warning: state " << s << " can never accept\n";
+        if (report.states_after < report.states_before)
+            std::cerr << "gen_scanner: minimized " << report.states_before << " -> " << report.states_after << " states\n";
+    } catch (const std::exception& e) {
+        std::cerr << "gen_scanner: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::ofstream out(argv[2]);
+    if (!out) {
+        std::cerr << "gen_scanner: cannot write " << argv[2] << "\n";
+        return 1;
+    }
+
+    out << "// Generated by tools/gen_scanner from " << in_path << ". Do not edit.\n";
+    out << "#include \"lexer/dfa_loader.hpp\"\n\n";
+
+    // the same DFA as constexpr tables, for table-driven callers (builtin_dfa)
+    const size_t n = dfa.size();
+    out << "static constexpr std::string_view STATE_NAMES[" << n << "] = {\n";
+    for (size_t s = 0; s < n; ++s) {
+        std::string_view name = dfa.name(static_cast<int>(s));
+        // an embedded NUL would cut the literal short without the length
+        if (name.find('\0') != std::string_view::npos)
+            out << "    std::string_view(" << string_literal(name) << ", " << name.size() << "),\n";
+        else
+            out << "    " << string_literal(name) << ",\n";
+    }
+    out << "};\n\n";
+
+    out << "static constexpr unsigned char STATE_FINAL[" << n << "] = {";
+    for (size_t s = 0; s < n; ++s) out << (s % 16 == 0 ? "\n    " : " ") << (dfa.is_final(static_cast<int>(s)) ? 1 : 0) << ",";
+    out << "\n};\n\n";
+
+    out << "static constexpr int TRANSITIONS[" << n << " * 256] = {\n";
+    for (size_t s = 0; s < n; ++s) {
+        out << "    // " << comment_text(dfa.name(static_cast<int>(s)));
+        for (int b = 0; b < 256; ++b) {
+            out << (b % 16 == 0 ? "\n    " : " ") << dfa.next(static_cast<int>(s), static_cast<unsigned char>(b)) << ",";
+        }
+        out << "\n";
+    }
+    out << "};\n\n";
+
+    out << "const CompiledDFA& builtin_dfa() {\n";
+    out << "    static const CompiledDFA dfa(" << dfa.start() << ", " << n << ", STATE_NAMES, STATE_FINAL, TRANSITIONS);\n";
+    out << "    return dfa;\n";
+    out << "}\n\n";
+
+    out << "ScanMatch generated_scan(std::string_view src, size_t from) {\n";
+    out << "    const unsigned char* p = reinterpret_cast<const unsigned char*>(src.data());\n";
+    out << "    const size_t n = src.size();\n";
+    out << "    size_t i = from;\n";
+    out << "    ScanMatch m{-1, from, from};\n";
+    out << "    goto L_" << dfa.start() << ";\n\n";
+    std::vector<bool> targeted(dfa.size(), false);
+    for (size_t s = 0; s < dfa.size(); ++s)
+        for (int b = 0; b < 256; ++b) {
+            int t = dfa.next(static_cast<int>(s), static_cast<unsigned char>(b));
+            if (t != CompiledDFA::DEAD) targeted[t] = true;
+        }
+    for (size_t s = 0; s < dfa.size(); ++s) {
+        // states no transition reaches need no code
+        if (!targeted[s] && static_cast<int>(s) != dfa.start()) continue;
+        emit_state(out, dfa, static_cast<int>(s), targeted[s]);
+    }
+    out << "done:\n";
+    out << "    m.stop = i;\n";
+    out << "    return m;\n";
+    out << "}\n";
+    return 0;
+}